@@ -20,6 +20,9 @@ extern "C" {
     __disable_irq()
 #define CRITICAL_EXIT() __set_PRIMASK(__istate_val)
 
+#define PORT_FIND_LAST_SET(word) (31 - __CLZ(word))
+#define PORT_MEMORY_BARRIER() __DMB()
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,7 +24,18 @@ typedef int32_t difftick_t;
 #define LIBRERTOS_DISABLE_TIMERS 0
 #define LIBRERTOS_DISABLE_SEMAPHORES 0
 #define LIBRERTOS_DISABLE_MUTEXES 0
+#define LIBRERTOS_DISABLE_CONDVARS 0
+#define LIBRERTOS_DISABLE_RWLOCKS 0
 #define LIBRERTOS_DISABLE_QUEUES 0
+#define LIBRERTOS_DISABLE_SPSC_QUEUES 0
+#define LIBRERTOS_DISABLE_MAILBOXES 0
+#define LIBRERTOS_DISABLE_STREAM_BUFFERS 0
+#define LIBRERTOS_DISABLE_TOPICS 0
+#define LIBRERTOS_DISABLE_CHANNELS 0
+#define LIBRERTOS_DISABLE_BARRIERS 0
+#define LIBRERTOS_DISABLE_TASK_NOTIFICATIONS 0
+#define LIBRERTOS_DISABLE_EVENT_GROUPS 0
+#define LIBRERTOS_DISABLE_QUEUE_SETS 0
 
 #ifdef __cplusplus
 }
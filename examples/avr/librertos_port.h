@@ -25,6 +25,10 @@ extern "C" {
     __asm __volatile("out __SREG__, %0 \n\t" ::"r"(__istate_val) \
                      : "memory")
 
+/* Single core: a compiler barrier orders the SPSC queue accesses. */
+#define PORT_MEMORY_BARRIER() __asm __volatile("" :: \
+                                                   : "memory")
+
 void port_init(void);
 void port_enable_tick_interrupt(void);
 void idle_wait_interrupt(void);
@@ -24,6 +24,10 @@ extern "C" {
 typedef uint16_t tick_t;
 typedef int16_t difftick_t;
 
+/* Smaller timing wheel and events to save RAM. */
+#define TIMING_WHEEL_BITS 2
+#define EVENT_PRIORITY_LISTS 1
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#ifndef LIBRERTOS_PROJ_H_
+#define LIBRERTOS_PROJ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+
+#define LIBRERTOS_ASSERT(expr, msg) assert(expr)
+
+#define KERNEL_MODE LIBRERTOS_COOPERATIVE
+#define NUM_PRIORITIES 8
+
+#define TICKS_PER_SECOND 100
+#define TICK_PERIOD (1.0 / TICKS_PER_SECOND)
+
+/* The benchmarks do not use the tick thread. */
+#define TICKLESS_IDLE 0
+
+typedef uint32_t tick_t;
+typedef int32_t difftick_t;
+
+#define LIBRERTOS_DISABLE_TIMERS 0
+#define LIBRERTOS_DISABLE_SEMAPHORES 0
+#define LIBRERTOS_DISABLE_MUTEXES 0
+#define LIBRERTOS_DISABLE_CONDVARS 0
+#define LIBRERTOS_DISABLE_RWLOCKS 0
+#define LIBRERTOS_DISABLE_QUEUES 0
+#define LIBRERTOS_DISABLE_SPSC_QUEUES 0
+#define LIBRERTOS_DISABLE_MAILBOXES 0
+#define LIBRERTOS_DISABLE_STREAM_BUFFERS 0
+#define LIBRERTOS_DISABLE_TOPICS 0
+#define LIBRERTOS_DISABLE_CHANNELS 0
+#define LIBRERTOS_DISABLE_BARRIERS 0
+#define LIBRERTOS_DISABLE_TASK_NOTIFICATIONS 0
+#define LIBRERTOS_DISABLE_EVENT_GROUPS 0
+#define LIBRERTOS_DISABLE_QUEUE_SETS 0
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRERTOS_PROJ_H_ */
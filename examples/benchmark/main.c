@@ -0,0 +1,186 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+/*
+ * Project tested on Ubuntu 22.04.
+ *
+ * Benchmarks of the kernel objects, run without the tick thread.
+ *
+ * Event policy: NUM_TASKS tasks with different priorities compete for a
+ * semaphore. Each task waits, takes the semaphore when resumed and waits
+ * again. Compare how the wakeups are shared among the priorities with
+ * EVENT_POLICY_PRIORITY and EVENT_POLICY_FIFO. The time per wakeup is the
+ * same for both policies.
+ *
+ * Queues: write and read items through a queue_t, which uses critical
+ * sections, and through a lock-free spsc_queue_t.
+ *
+ * Locks: NUM_TASKS tasks wait for a lock held by main() and access the
+ * protected data when it is unlocked, through a mutex_t and through a
+ * rwlock_t with only readers and with one writer every WRITER_EVERY tasks.
+ */
+
+#include "librertos.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define NUM_TASKS 64
+#define NUM_WAKEUPS 1000000
+#define NUM_ITEMS 10000000
+#define QUEUE_SIZE 16
+#define NUM_ROUNDS 20000
+#define WRITER_EVERY 8
+
+static task_t task[NUM_TASKS];
+static unsigned long wakeups[NUM_PRIORITIES];
+static semaphore_t sem;
+static mutex_t mtx;
+static rwlock_t rw;
+static unsigned long accesses;
+
+static double get_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void func_task_semaphore(void *param) {
+    /* Take the semaphore or wait for it. */
+    if (semaphore_lock_suspend(&sem, MAX_DELAY))
+        wakeups[(intptr_t)param]++;
+}
+
+static void benchmark_event_policy(const char *name, event_policy_t policy) {
+    double start, seconds;
+    intptr_t i;
+
+    librertos_init();
+    semaphore_init_locked(&sem, 1);
+    semaphore_set_policy(&sem, policy);
+
+    for (i = 0; i < NUM_PRIORITIES; ++i)
+        wakeups[i] = 0;
+    for (i = 0; i < NUM_TASKS; ++i)
+        librertos_create_task(i % NUM_PRIORITIES, &task[i], &func_task_semaphore, (void *)(i % NUM_PRIORITIES));
+
+    /* All tasks wait for the semaphore. */
+    librertos_start();
+    librertos_sched();
+
+    start = get_seconds();
+    for (i = 0; i < NUM_WAKEUPS; ++i) {
+        semaphore_unlock(&sem);
+        librertos_sched();
+    }
+    seconds = get_seconds() - start;
+
+    printf("%-9s %7.1f ns/wakeup  wakeups per priority:", name, seconds * 1e9 / NUM_WAKEUPS);
+    for (i = NUM_PRIORITIES - 1; i >= 0; --i)
+        printf(" %lu", wakeups[i]);
+    printf("\n");
+}
+
+static void benchmark_queues(void) {
+    static uint32_t buff[QUEUE_SIZE];
+    queue_t que;
+    spsc_queue_t spsc;
+    double start, seconds;
+    uint32_t i, data = 0;
+
+    librertos_init();
+    queue_init(&que, &buff[0], QUEUE_SIZE, sizeof(buff[0]));
+    spsc_queue_init(&spsc, &buff[0], QUEUE_SIZE, sizeof(buff[0]));
+
+    start = get_seconds();
+    for (i = 0; i < NUM_ITEMS; ++i) {
+        queue_write(&que, &i);
+        queue_read(&que, &data);
+    }
+    seconds = get_seconds() - start;
+    printf("%-9s %7.1f ns/item\n", "queue", seconds * 1e9 / NUM_ITEMS);
+
+    start = get_seconds();
+    for (i = 0; i < NUM_ITEMS; ++i) {
+        spsc_queue_write(&spsc, &i);
+        spsc_queue_read(&spsc, &data);
+    }
+    seconds = get_seconds() - start;
+    printf("%-9s %7.1f ns/item\n", "spsc", seconds * 1e9 / NUM_ITEMS);
+}
+
+static void func_task_mutex(void *param) {
+    (void)param;
+
+    /* Access once per round, then wait for the next round. */
+    if (mutex_lock_suspend(&mtx, MAX_DELAY)) {
+        accesses++;
+        mutex_unlock(&mtx);
+        task_suspend(NULL);
+    }
+}
+
+static void func_task_rwlock(void *param) {
+    uint8_t writer = (param != NULL);
+
+    /* Access once per round, then wait for the next round. */
+    if (writer ? rwlock_write_lock_suspend(&rw, MAX_DELAY) : rwlock_read_lock_suspend(&rw, MAX_DELAY)) {
+        accesses++;
+        if (writer)
+            rwlock_write_unlock(&rw);
+        else
+            rwlock_read_unlock(&rw);
+        task_suspend(NULL);
+    }
+}
+
+static void benchmark_locks(const char *name, uint8_t use_rwlock, uint8_t writer_every) {
+    double start, seconds;
+    intptr_t i;
+
+    librertos_init();
+    mutex_init(&mtx);
+    rwlock_init(&rw);
+    accesses = 0;
+
+    for (i = 0; i < NUM_TASKS; ++i) {
+        uint8_t writer = (writer_every != 0 && i % writer_every == 0);
+        librertos_create_task(i % NUM_PRIORITIES, &task[i],
+            use_rwlock ? &func_task_rwlock : &func_task_mutex, (void *)(intptr_t)writer);
+    }
+
+    librertos_start();
+
+    start = get_seconds();
+    for (i = 0; i < NUM_ROUNDS; ++i) {
+        /* All tasks wait for the lock. */
+        if (use_rwlock)
+            rwlock_write_lock(&rw);
+        else
+            mutex_lock(&mtx);
+        task_resume_all();
+        librertos_sched();
+
+        /* All tasks access the data. */
+        if (use_rwlock)
+            rwlock_write_unlock(&rw);
+        else
+            mutex_unlock(&mtx);
+        librertos_sched();
+    }
+    seconds = get_seconds() - start;
+
+    printf("%-9s %7.1f ns/access  accesses: %lu\n", name, seconds * 1e9 / accesses, accesses);
+}
+
+int main(void) {
+    port_init();
+
+    benchmark_event_policy("PRIORITY", EVENT_POLICY_PRIORITY);
+    benchmark_event_policy("FIFO", EVENT_POLICY_FIFO);
+    benchmark_queues();
+    benchmark_locks("mutex", 0, 0);
+    benchmark_locks("rwlock", 1, 0);
+    benchmark_locks("rwlock-w", 1, WRITER_EVERY);
+
+    return 0;
+}
@@ -1,30 +1,93 @@
 /* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "librertos.h"
 #include <pthread.h>
 #include <semaphore.h>
-#include <unistd.h>
+#include <time.h>
 
 static pthread_t tick_interrupt;
 static sem_t idle_wakeup;
 static pthread_mutex_t mutual_exclusion;
 
+/* Protects the tick thread state below. */
+static pthread_mutex_t tick_mutex;
+static pthread_cond_t tick_cond;
+static struct timespec tick_start;
+static tick_t tick_start_count;
+static int idle_sleeping;
+static tick_t idle_sleep_until;
+
+/* Number of tick periods since tick_start. */
+static unsigned long long get_elapsed_ticks(void) {
+    struct timespec now;
+    double seconds;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    seconds = (now.tv_sec - tick_start.tv_sec) + (now.tv_nsec - tick_start.tv_nsec) * 1e-9;
+
+    return (unsigned long long)(seconds / TICK_PERIOD);
+}
+
+/* Absolute time of a number of tick periods since tick_start. */
+static struct timespec get_tick_time(unsigned long long ticks) {
+    struct timespec time = tick_start;
+    double seconds = ticks * TICK_PERIOD;
+    long nsec = (long)((seconds - (time_t)seconds) * 1e9);
+
+    time.tv_sec += (time_t)seconds;
+    time.tv_nsec += nsec;
+    if (time.tv_nsec >= 1000000000L) {
+        time.tv_sec += 1;
+        time.tv_nsec -= 1000000000L;
+    }
+
+    return time;
+}
+
 static void *func_tick_interrupt(void *param) {
+    unsigned long long ticks_done = 0;
     int retval;
     INTERRUPTS_VAL();
     (void)param;
 
     while (1) {
         task_t *interrupted_task;
+        unsigned long long ticks_elapsed;
+
+        /* Wait for the next tick or, while the idle task sleeps, for the
+         * next wakeup of the kernel. */
+        pthread_mutex_lock(&tick_mutex);
+        while (1) {
+            unsigned long long next = ticks_done + 1;
+            struct timespec time;
+
+            if (idle_sleeping) {
+                tick_t now = (tick_t)(tick_start_count + ticks_done);
+                tick_t ticks = (tick_t)(idle_sleep_until - now);
+
+                /* Zero means a whole tick counter period. */
+                next = ticks_done + ((ticks != 0) ? ticks : (unsigned long long)MAX_DELAY + 1);
+            }
+
+            ticks_elapsed = get_elapsed_ticks();
+            if (ticks_elapsed >= next)
+                break;
 
-        usleep(1000000 * TICK_PERIOD);
+            time = get_tick_time(next);
+            pthread_cond_timedwait(&tick_cond, &tick_mutex, &time);
+        }
+        pthread_mutex_unlock(&tick_mutex);
 
         INTERRUPTS_DISABLE();
         interrupted_task = interrupt_lock();
-        librertos_tick_interrupt();
+        librertos_tick_advance((tick_t)(ticks_elapsed - ticks_done));
         interrupt_unlock(interrupted_task);
         INTERRUPTS_ENABLE();
 
+        ticks_done = ticks_elapsed;
+
         retval = sem_post(&idle_wakeup);
         LIBRERTOS_ASSERT(retval == 0, "func_tick_interrupt(): Could not unlock (post) semaphore.");
     }
@@ -35,6 +98,7 @@ static void *func_tick_interrupt(void *param) {
 void port_init(void) {
     int retval;
     pthread_mutexattr_t attr;
+    pthread_condattr_t cond_attr;
 
     retval = sem_init(&idle_wakeup, 0, 0);
     LIBRERTOS_ASSERT(retval == 0, "port_init(): Could not initialize semaphore.");
@@ -44,17 +108,61 @@ void port_init(void) {
     retval |= pthread_mutex_init(&mutual_exclusion, &attr);
     retval |= pthread_mutexattr_destroy(&attr);
     LIBRERTOS_ASSERT(retval == 0, "port_init(): Could not initialize mutex.");
+
+    retval = pthread_mutex_init(&tick_mutex, NULL);
+    retval |= pthread_condattr_init(&cond_attr);
+    retval |= pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    retval |= pthread_cond_init(&tick_cond, &cond_attr);
+    retval |= pthread_condattr_destroy(&cond_attr);
+    LIBRERTOS_ASSERT(retval == 0, "port_init(): Could not initialize tick condition.");
 }
 
 void port_enable_tick_interrupt(void) {
-    int retval =
-        pthread_create(&tick_interrupt, NULL, &func_tick_interrupt, NULL);
+    int retval;
+
+    tick_start_count = get_tick();
+    clock_gettime(CLOCK_MONOTONIC, &tick_start);
+
+    retval = pthread_create(&tick_interrupt, NULL, &func_tick_interrupt, NULL);
     LIBRERTOS_ASSERT(retval == 0, "port_enable_tick_interrupt(): Could not create tick thread.");
 }
 
 void idle_wait_interrupt(void) {
+#if TICKLESS_IDLE
+    tick_t wakeup;
+
+    /* No delayed tasks: sleep a whole tick counter period. */
+    if (!get_next_wakeup(&wakeup))
+        wakeup = get_tick();
+
+    port_sleep_until(wakeup);
+#else
     int retval = sem_wait(&idle_wakeup);
     LIBRERTOS_ASSERT(retval == 0, "idle_wait_interrupt(): Could not lock (wait) semaphore.");
+#endif
+}
+
+/*
+ * Sleep without tick interrupts until the tick, or until another interrupt.
+ * If the tick counter advanced since the tick was calculated, the tick
+ * thread has posted the semaphore and the function returns immediately.
+ */
+void port_sleep_until(tick_t tick) {
+    int retval;
+
+    pthread_mutex_lock(&tick_mutex);
+    idle_sleeping = 1;
+    idle_sleep_until = tick;
+    pthread_cond_signal(&tick_cond);
+    pthread_mutex_unlock(&tick_mutex);
+
+    retval = sem_wait(&idle_wakeup);
+    LIBRERTOS_ASSERT(retval == 0, "port_sleep_until(): Could not lock (wait) semaphore.");
+
+    pthread_mutex_lock(&tick_mutex);
+    idle_sleeping = 0;
+    pthread_cond_signal(&tick_cond);
+    pthread_mutex_unlock(&tick_mutex);
 }
 
 void INTERRUPTS_DISABLE(void) {
@@ -17,9 +17,12 @@ void INTERRUPTS_ENABLE(void);
 void CRITICAL_ENTER(void);
 void CRITICAL_EXIT(void);
 
+#define PORT_FIND_LAST_SET(word) (31 - __builtin_clz(word))
+
 void port_init(void);
 void port_enable_tick_interrupt(void);
 void idle_wait_interrupt(void);
+void port_sleep_until(tick_t tick);
 
 #ifdef __cplusplus
 }
@@ -18,13 +18,27 @@ extern "C" {
 #define TICKS_PER_SECOND 100
 #define TICK_PERIOD (1.0 / TICKS_PER_SECOND)
 
+/* Stop the tick while the idle task sleeps. */
+#define TICKLESS_IDLE 1
+
 typedef uint32_t tick_t;
 typedef int32_t difftick_t;
 
 #define LIBRERTOS_DISABLE_TIMERS 0
 #define LIBRERTOS_DISABLE_SEMAPHORES 0
 #define LIBRERTOS_DISABLE_MUTEXES 0
+#define LIBRERTOS_DISABLE_CONDVARS 0
+#define LIBRERTOS_DISABLE_RWLOCKS 0
 #define LIBRERTOS_DISABLE_QUEUES 0
+#define LIBRERTOS_DISABLE_SPSC_QUEUES 0
+#define LIBRERTOS_DISABLE_MAILBOXES 0
+#define LIBRERTOS_DISABLE_STREAM_BUFFERS 0
+#define LIBRERTOS_DISABLE_TOPICS 0
+#define LIBRERTOS_DISABLE_CHANNELS 0
+#define LIBRERTOS_DISABLE_BARRIERS 0
+#define LIBRERTOS_DISABLE_TASK_NOTIFICATIONS 0
+#define LIBRERTOS_DISABLE_EVENT_GROUPS 0
+#define LIBRERTOS_DISABLE_QUEUE_SETS 0
 
 #ifdef __cplusplus
 }
@@ -10,12 +10,153 @@ extern "C" {
 #include "librertos_proj.h"
 
 #include "librertos_port.h"
+#include <stddef.h>
 #include <stdint.h>
 
 #define MAX_DELAY ((tick_t)-1)
 
+/* Task notifications, event groups, queue sets, semaphores, queues, channels,
+ * mutexes, barriers and reader-writer locks add fields to task_t, queue_t and
+ * semaphore_t, so these features are selected here instead of in librertos.c.
+ */
+#ifndef LIBRERTOS_DISABLE_TASK_NOTIFICATIONS
+    #define LIBRERTOS_DISABLE_TASK_NOTIFICATIONS 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_EVENT_GROUPS
+    #define LIBRERTOS_DISABLE_EVENT_GROUPS 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_QUEUE_SETS
+    #define LIBRERTOS_DISABLE_QUEUE_SETS 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_SEMAPHORES
+    #define LIBRERTOS_DISABLE_SEMAPHORES 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_QUEUES
+    #define LIBRERTOS_DISABLE_QUEUES 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_CHANNELS
+    #define LIBRERTOS_DISABLE_CHANNELS 0 /* Enabled by default. */
+#endif
+
+/* Queue sets are built on a queue. */
+#if (LIBRERTOS_DISABLE_QUEUES != 0)
+    #undef LIBRERTOS_DISABLE_QUEUE_SETS
+    #define LIBRERTOS_DISABLE_QUEUE_SETS 1
+#endif
+
+#ifndef LIBRERTOS_DISABLE_MUTEXES
+    #define LIBRERTOS_DISABLE_MUTEXES 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_BARRIERS
+    #define LIBRERTOS_DISABLE_BARRIERS 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_RWLOCKS
+    #define LIBRERTOS_DISABLE_RWLOCKS 0 /* Enabled by default. */
+#endif
+
+/* Priority bitmap: one bit per priority, grouped in 16-bit words, plus a
+ * summary word with one bit per non-empty word. Two levels of 16 bits cover
+ * up to 256 priorities.
+ */
+#define PRIORITY_BITMAP_BITS 16
+#define PRIORITY_BITMAP_WORDS \
+    ((NUM_PRIORITIES + PRIORITY_BITMAP_BITS - 1) / PRIORITY_BITMAP_BITS)
+
+/* Number of lists of waiting tasks in each event (semaphore, mutex, queue...).
+ * With one list per priority, the default, waiting and resuming take constant
+ * time. With fewer lists each list holds a range of priorities, kept sorted
+ * on insertion, which saves RAM in every event. The project can define it
+ * from 1 to NUM_PRIORITIES.
+ */
+#ifndef EVENT_PRIORITY_LISTS
+    #define EVENT_PRIORITY_LISTS NUM_PRIORITIES
+#endif
+#if (EVENT_PRIORITY_LISTS < 1 || EVENT_PRIORITY_LISTS > NUM_PRIORITIES)
+    #error "EVENT_PRIORITY_LISTS must be 1 to NUM_PRIORITIES."
+#endif
+
+/* Hierarchical timing wheel of delayed tasks: each level has
+ * TIMING_WHEEL_SIZE lists (buckets) and covers TIMING_WHEEL_BITS bits of the
+ * tick counter. The project can define TIMING_WHEEL_BITS to trade memory for
+ * cascading work.
+ */
+#ifndef TIMING_WHEEL_BITS
+    #define TIMING_WHEEL_BITS 4
+#endif
+#if (TIMING_WHEEL_BITS < 1 || TIMING_WHEEL_BITS > 4)
+    #error "TIMING_WHEEL_BITS must be 1 to 4, the buckets of a level are bits of a 16-bit word."
+#endif
+#define TIMING_WHEEL_SIZE (1 << TIMING_WHEEL_BITS)
+#define TIMING_WHEEL_MASK ((uint16_t)(0xFFFFU >> (16 - TIMING_WHEEL_SIZE)))
+#define TIMING_WHEEL_LEVELS \
+    ((uint8_t)((sizeof(tick_t) * 8 + TIMING_WHEEL_BITS - 1) / TIMING_WHEEL_BITS))
+
+/* Widths of the list lengths (tasks in a list), semaphore counts, queue
+ * sizes (number of items) and queue item sizes. The project can define them
+ * in librertos_proj.h with larger types, such as uint16_t.
+ */
+#ifndef LIST_LENGTH_TYPE
+    #define LIST_LENGTH_TYPE uint8_t
+#endif
+#ifndef SEMAPHORE_COUNT_TYPE
+    #define SEMAPHORE_COUNT_TYPE uint8_t
+#endif
+#ifndef QUEUE_SIZE_TYPE
+    #define QUEUE_SIZE_TYPE uint8_t
+#endif
+#ifndef ITEM_SIZE_TYPE
+    #define ITEM_SIZE_TYPE uint8_t
+#endif
+
+/* Number of item priorities of the priority queues. */
+#ifndef PRIO_QUEUE_LEVELS
+    #define PRIO_QUEUE_LEVELS 4
+#endif
+
+/* Width of the mailbox version. A reader that misses a multiple of its range
+ * of writes sees the same version, so the project can define a larger type.
+ */
+#ifndef MAILBOX_VERSION_TYPE
+    #define MAILBOX_VERSION_TYPE uint8_t
+#endif
+
+/* Width of the topic sequence numbers. It must hold the number of items of
+ * the topics, and a subscriber that falls behind by a multiple of its range
+ * does not see the items it lost.
+ */
+#ifndef TOPIC_SEQUENCE_TYPE
+    #define TOPIC_SEQUENCE_TYPE uint16_t
+#endif
+
+/* Width of the task notification value. */
+#ifndef NOTIFY_VALUE_TYPE
+    #define NOTIFY_VALUE_TYPE uint8_t
+#endif
+
+/* Width of the event group bit mask. */
+#ifndef EVENT_BITS_TYPE
+    #define EVENT_BITS_TYPE uint8_t
+#endif
+
+typedef LIST_LENGTH_TYPE list_len_t;
+typedef SEMAPHORE_COUNT_TYPE sem_count_t;
+typedef QUEUE_SIZE_TYPE queue_size_t;
+typedef ITEM_SIZE_TYPE item_size_t;
+typedef MAILBOX_VERSION_TYPE mailbox_version_t;
+typedef TOPIC_SEQUENCE_TYPE topic_seq_t;
+typedef NOTIFY_VALUE_TYPE notify_value_t;
+typedef EVENT_BITS_TYPE event_bits_t;
+
 struct os_task_t;
 struct node_t;
+struct queue_set_t;
 
 typedef enum {
     LIBRERTOS_FAIL = 0,
@@ -32,6 +173,45 @@ typedef enum {
     LIBRERTOS_COOPERATIVE
 } kernel_mode_t;
 
+typedef enum {
+    EVENT_POLICY_PRIORITY = 0, /* Higher priority first, FIFO within a priority. */
+    EVENT_POLICY_FIFO          /* Arrival order, regardless of priority. */
+} event_policy_t;
+
+/* Default order in which semaphores, mutexes and queues resume waiting tasks.
+ * Can be changed per object with semaphore_set_policy(), mutex_set_policy()
+ * and queue_set_policy().
+ */
+#ifndef EVENT_POLICY
+    #define EVENT_POLICY EVENT_POLICY_PRIORITY
+#endif
+
+/* Default handoff mode of semaphores, mutexes and queues. With handoff the
+ * unlock (or write) grants the resource directly to the task it resumes,
+ * which must take it retrying the same lock (or read) before waiting for any
+ * other event.
+ * Can be changed per object with semaphore_set_handoff(), mutex_set_handoff()
+ * and queue_set_handoff().
+ */
+#ifndef EVENT_HANDOFF
+    #define EVENT_HANDOFF 0
+#endif
+
+/* How task_notify() changes the notification value of the task. */
+typedef enum {
+    NOTIFY_SET_BITS = 0, /* Value |= bits. */
+    NOTIFY_INCREMENT,    /* Value += 1, the bits are ignored. */
+    NOTIFY_OVERWRITE     /* Value = bits. */
+} notify_action_t;
+
+/* Why a task waiting for an event was resumed. */
+typedef enum {
+    TASK_WAKE_NONE = 0, /* Still waiting, or never waited for an event. */
+    TASK_WAKE_ACQUIRED, /* Granted the resource by a handoff. */
+    TASK_WAKE_TIMED_OUT, /* The ticks to delay passed. */
+    TASK_WAKE_RESUMED /* Resumed by the event or by task_resume(), retry. */
+} task_wake_t;
+
 typedef enum {
     TIMERTYPE_AUTO = 1, /* Auto reset timer after it has run. */
     TIMERTYPE_ONESHOT   /* Timer need to be reset to run. */
@@ -40,7 +220,7 @@ typedef enum {
 struct list_t {
     struct node_t *head;
     struct node_t *tail;
-    uint8_t length;
+    list_len_t length;
 };
 
 struct node_t {
@@ -50,33 +230,186 @@ struct node_t {
     void *owner;
 };
 
+struct priority_bitmap_t {
+    uint16_t summary;
+    uint16_t words[PRIORITY_BITMAP_WORDS];
+};
+
+/* Tasks waiting for an event, EVENT_PRIORITY_LISTS lists of priority ranges.
+ * With EVENT_POLICY_FIFO all tasks wait in the first list.
+ */
 typedef struct {
-    struct list_t suspended_tasks;
+    struct list_t suspended_tasks[EVENT_PRIORITY_LISTS];
+    struct priority_bitmap_t priorities;
+    uint8_t policy;
+    uint8_t handoff;
 } event_t;
 
 typedef struct {
-    uint8_t count;
-    uint8_t max;
+    sem_count_t count;
+    sem_count_t max;
     event_t event_unlock;
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    struct queue_set_t *set;
+#endif
 } semaphore_t;
 
-typedef struct {
+typedef struct mutex_t {
     uint8_t count;
     struct os_task_t *task_owner;
+    struct mutex_t *next_held; /* Next mutex held by the owner. */
     event_t event_unlock;
 } mutex_t;
 
+/* Condition variable bound to a mutex. Tasks wait on event_signal. */
+typedef struct {
+    mutex_t *mtx;
+    event_t event_signal;
+} condvar_t;
+
+/* Reader-writer lock. Readers wait on event_read and writers on event_write.
+ * The writer inherits the priority of the tasks waiting for the lock.
+ */
+typedef struct rwlock_t {
+    list_len_t readers;
+    uint8_t write_locked;
+    uint8_t writer_preference;
+    struct os_task_t *writer;
+    struct rwlock_t *next_held; /* Next lock held by the writer. */
+    event_t event_read;
+    event_t event_write;
+} rwlock_t;
+
 typedef struct {
-    uint8_t free;
-    uint8_t used;
-    uint16_t head;
-    uint16_t tail;
-    uint16_t item_size;
-    uint16_t end;
+    queue_size_t free;
+    queue_size_t used;
+    size_t head;
+    size_t tail;
+    item_size_t item_size;
+    size_t end;
     uint8_t *buff;
     event_t event_write;
+    event_t event_read;
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    struct queue_set_t *set;
+#endif
 } queue_t;
 
+/* Set of queues and semaphores a task can wait on at once. Its queue holds
+ * a pointer to the member for each item written to a member queue or unit
+ * unlocked in a member semaphore.
+ */
+typedef struct queue_set_t {
+    queue_t que;
+} queue_set_t;
+
+/* Priority queue. The slots are linked in a free list and in a FIFO list
+ * per priority by the links array; the index size ends a list.
+ */
+typedef struct {
+    queue_size_t first[PRIO_QUEUE_LEVELS];
+    queue_size_t last[PRIO_QUEUE_LEVELS];
+    queue_size_t free_slot;
+    queue_size_t size;
+    queue_size_t used;
+    item_size_t item_size;
+    queue_size_t *links;
+    uint8_t *buff;
+    event_t event_write;
+} prio_queue_t;
+
+/* Lock-free single-producer single-consumer queue. The head is written only
+ * by the producer and the tail only by the consumer; both count items
+ * without wrapping to the queue size.
+ */
+typedef struct {
+    volatile queue_size_t head;
+    volatile queue_size_t tail;
+    queue_size_t mask;
+    item_size_t item_size;
+    volatile uint8_t consumer_suspended;
+    uint8_t *buff;
+    event_t event_write;
+} spsc_queue_t;
+
+/* Single-value mailbox. The version is incremented by each write. */
+typedef struct {
+    mailbox_version_t version;
+    item_size_t item_size;
+    uint8_t *buff;
+    event_t event_write;
+} mailbox_t;
+
+/* Stream buffer of bytes. A reader is resumed when at least trigger bytes
+ * are available.
+ */
+typedef struct {
+    queue_size_t head;
+    queue_size_t tail;
+    queue_size_t used;
+    queue_size_t size;
+    queue_size_t trigger;
+    uint8_t *buff;
+    event_t event_write;
+} stream_buffer_t;
+
+/* Message buffer. Each message is prefixed by its length as item_size_t. */
+typedef struct {
+    stream_buffer_t stream;
+} message_buffer_t;
+
+/* Publish/subscribe topic. The sequence counts the items published and the
+ * head is the slot of the next item published.
+ */
+typedef struct {
+    topic_seq_t sequence;
+    queue_size_t head;
+    queue_size_t size;
+    item_size_t item_size;
+    uint8_t *buff;
+    struct list_t subscribers;
+} topic_t;
+
+/* Topic subscriber. The cursor is the sequence of the next item to read. */
+typedef struct {
+    struct node_t node;
+    topic_t *topic;
+    topic_seq_t cursor;
+    topic_seq_t skipped;
+    event_t event_write;
+} subscriber_t;
+
+/* Rendezvous channel without buffer. Readers wait on event_write and
+ * writers on event_read.
+ */
+typedef struct {
+    item_size_t item_size;
+    event_t event_write;
+    event_t event_read;
+} channel_t;
+
+/* Group of event bits. The tasks wait on event_write for a combination of
+ * bits, which they keep in task_t.
+ */
+typedef struct {
+    event_bits_t bits;
+    event_t event_write;
+} event_group_t;
+
+/* Cyclic barrier for a number of parties. Tasks wait on event_release. */
+typedef struct {
+    sem_count_t parties;
+    sem_count_t arrived;
+    sem_count_t generation;
+    event_t event_release;
+} barrier_t;
+
+/* Countdown latch, open when the count reaches zero. */
+typedef struct {
+    sem_count_t count;
+    event_t event_release;
+} latch_t;
+
 typedef void *task_parameter_t;
 typedef void (*task_function_t)(task_parameter_t param);
 
@@ -89,6 +422,32 @@ typedef struct os_task_t {
     tick_t delay_until;
     struct node_t sched_node;
     struct node_t event_node;
+    event_t *event;
+#if (LIBRERTOS_DISABLE_QUEUES == 0 || LIBRERTOS_DISABLE_CHANNELS == 0)
+    void *handoff_data; /* Buffer of the reader for a direct handoff. */
+#endif
+    uint8_t wake_result;
+#if (LIBRERTOS_DISABLE_SEMAPHORES == 0)
+    sem_count_t wait_count; /* Semaphore units. */
+#endif
+#if (LIBRERTOS_DISABLE_MUTEXES == 0)
+    struct mutex_t *held_mutexes; /* Mutexes owned by the task. */
+    struct mutex_t *blocked_mutex; /* Mutex the task waited for last. */
+#endif
+#if (LIBRERTOS_DISABLE_RWLOCKS == 0)
+    struct rwlock_t *held_rwlocks; /* Locks held for writing by the task. */
+#endif
+#if (LIBRERTOS_DISABLE_TASK_NOTIFICATIONS == 0)
+    notify_value_t notify_value;
+    uint8_t notify_state;
+#endif
+#if (LIBRERTOS_DISABLE_EVENT_GROUPS == 0)
+    event_bits_t wait_bits;
+    uint8_t wait_flags;
+#endif
+#if (LIBRERTOS_DISABLE_BARRIERS == 0)
+    sem_count_t barrier_generation; /* Barrier cycle the task arrived in. */
+#endif
 } task_t;
 
 struct timer_task_t;
@@ -113,13 +472,18 @@ task_t *interrupt_lock(void);
 void interrupt_unlock(task_t *interrupted_task);
 
 void librertos_tick_interrupt(void);
+void librertos_tick_advance(tick_t ticks);
 tick_t get_tick(void);
+result_t get_next_wakeup(tick_t *wakeup_tick);
 
 void librertos_create_task(int8_t priority, task_t *task,
     task_function_t func, task_parameter_t param);
 void task_delay(tick_t ticks_to_delay);
 void task_suspend(task_t *task);
 void task_resume(task_t *task);
+task_wake_t task_get_wake_result(task_t *task);
+void task_notify(task_t *task, notify_action_t action, notify_value_t bits);
+result_t task_notify_wait(notify_value_t clear_bits, notify_value_t *value, tick_t ticks_to_delay);
 void task_resume_all(void);
 
 void librertos_create_timer(int8_t priority, timer_task_t *timer,
@@ -129,34 +493,145 @@ void timer_start(timer_task_t *timer);
 void timer_reset(timer_task_t *timer);
 void timer_stop(timer_task_t *timer);
 
-void semaphore_init(semaphore_t *sem, uint8_t init_count, uint8_t max_count);
-void semaphore_init_locked(semaphore_t *sem, uint8_t max_count);
-void semaphore_init_unlocked(semaphore_t *sem, uint8_t max_count);
+void semaphore_init(semaphore_t *sem, sem_count_t init_count, sem_count_t max_count);
+void semaphore_init_locked(semaphore_t *sem, sem_count_t max_count);
+void semaphore_init_unlocked(semaphore_t *sem, sem_count_t max_count);
+void semaphore_set_policy(semaphore_t *sem, event_policy_t policy);
+void semaphore_set_handoff(semaphore_t *sem, uint8_t handoff);
 result_t semaphore_lock(semaphore_t *sem);
 result_t semaphore_unlock(semaphore_t *sem);
-uint8_t semaphore_get_count(semaphore_t *sem);
-uint8_t semaphore_get_max(semaphore_t *sem);
+result_t semaphore_lock_n(semaphore_t *sem, sem_count_t num);
+sem_count_t semaphore_unlock_n(semaphore_t *sem, sem_count_t num);
+sem_count_t semaphore_get_count(semaphore_t *sem);
+sem_count_t semaphore_get_max(semaphore_t *sem);
 void semaphore_suspend(semaphore_t *sem, tick_t ticks_to_delay);
 result_t semaphore_lock_suspend(semaphore_t *sem, tick_t ticks_to_delay);
+result_t semaphore_lock_n_suspend(semaphore_t *sem, sem_count_t num, tick_t ticks_to_delay);
 
 void mutex_init(mutex_t *mtx);
+void mutex_set_policy(mutex_t *mtx, event_policy_t policy);
+void mutex_set_handoff(mutex_t *mtx, uint8_t handoff);
 result_t mutex_lock(mutex_t *mtx);
 void mutex_unlock(mutex_t *mtx);
 uint8_t mutex_is_locked(mutex_t *mtx);
 void mutex_suspend(mutex_t *mtx, tick_t ticks_to_delay);
 result_t mutex_lock_suspend(mutex_t *mtx, tick_t ticks_to_delay);
 
-void queue_init(queue_t *que, void *buff, uint8_t que_size, uint8_t item_size);
+void condvar_init(condvar_t *cv, mutex_t *mtx);
+void condvar_wait(condvar_t *cv, tick_t ticks_to_delay);
+void condvar_signal(condvar_t *cv);
+void condvar_broadcast(condvar_t *cv);
+
+void rwlock_init(rwlock_t *rw);
+void rwlock_set_writer_preference(rwlock_t *rw, uint8_t writer_preference);
+result_t rwlock_read_lock(rwlock_t *rw);
+void rwlock_read_unlock(rwlock_t *rw);
+result_t rwlock_write_lock(rwlock_t *rw);
+void rwlock_write_unlock(rwlock_t *rw);
+void rwlock_read_suspend(rwlock_t *rw, tick_t ticks_to_delay);
+void rwlock_write_suspend(rwlock_t *rw, tick_t ticks_to_delay);
+result_t rwlock_read_lock_suspend(rwlock_t *rw, tick_t ticks_to_delay);
+result_t rwlock_write_lock_suspend(rwlock_t *rw, tick_t ticks_to_delay);
+
+void queue_init(queue_t *que, void *buff, queue_size_t que_size, item_size_t item_size);
+void queue_set_policy(queue_t *que, event_policy_t policy);
+void queue_set_handoff(queue_t *que, uint8_t handoff);
 result_t queue_read(queue_t *que, void *data);
 result_t queue_write(queue_t *que, const void *data);
+result_t queue_write_front(queue_t *que, const void *data);
+queue_size_t queue_read_n(queue_t *que, void *data, queue_size_t num_items);
+queue_size_t queue_write_n(queue_t *que, const void *data, queue_size_t num_items);
+void *queue_read_peek(queue_t *que);
+void queue_read_release(queue_t *que);
+void *queue_write_reserve(queue_t *que);
+void queue_write_commit(queue_t *que);
 uint8_t queue_is_empty(queue_t *que);
 uint8_t queue_is_full(queue_t *que);
-uint8_t queue_get_num_free(queue_t *que);
-uint8_t queue_get_num_used(queue_t *que);
-uint8_t queue_get_num_items(queue_t *que);
-uint8_t queue_get_item_size(queue_t *que);
+queue_size_t queue_get_num_free(queue_t *que);
+queue_size_t queue_get_num_used(queue_t *que);
+queue_size_t queue_get_num_items(queue_t *que);
+item_size_t queue_get_item_size(queue_t *que);
 void queue_suspend(queue_t *que, tick_t ticks_to_delay);
 result_t queue_read_suspend(queue_t *que, void *data, tick_t ticks_to_delay);
+void queue_write_wait(queue_t *que, tick_t ticks_to_delay);
+result_t queue_write_suspend(queue_t *que, const void *data, tick_t ticks_to_delay);
+
+void queue_set_init(queue_set_t *set, void *buff, queue_size_t set_size);
+void queue_set_add_queue(queue_set_t *set, queue_t *que);
+void queue_set_add_semaphore(queue_set_t *set, semaphore_t *sem);
+void queue_set_remove_queue(queue_set_t *set, queue_t *que);
+void queue_set_remove_semaphore(queue_set_t *set, semaphore_t *sem);
+void *queue_set_select(queue_set_t *set);
+void queue_set_suspend(queue_set_t *set, tick_t ticks_to_delay);
+void *queue_set_select_suspend(queue_set_t *set, tick_t ticks_to_delay);
+
+void prio_queue_init(prio_queue_t *que, void *buff, queue_size_t *links, queue_size_t que_size, item_size_t item_size);
+result_t prio_queue_read(prio_queue_t *que, void *data, uint8_t *priority);
+result_t prio_queue_write(prio_queue_t *que, const void *data, uint8_t priority);
+queue_size_t prio_queue_get_num_used(prio_queue_t *que);
+queue_size_t prio_queue_get_num_free(prio_queue_t *que);
+void prio_queue_suspend(prio_queue_t *que, tick_t ticks_to_delay);
+result_t prio_queue_read_suspend(prio_queue_t *que, void *data, uint8_t *priority, tick_t ticks_to_delay);
+
+void spsc_queue_init(spsc_queue_t *que, void *buff, queue_size_t que_size, item_size_t item_size);
+result_t spsc_queue_read(spsc_queue_t *que, void *data);
+result_t spsc_queue_write(spsc_queue_t *que, const void *data);
+queue_size_t spsc_queue_get_num_used(spsc_queue_t *que);
+void spsc_queue_suspend(spsc_queue_t *que, tick_t ticks_to_delay);
+result_t spsc_queue_read_suspend(spsc_queue_t *que, void *data, tick_t ticks_to_delay);
+
+void mailbox_init(mailbox_t *mbx, void *buff, item_size_t item_size);
+void mailbox_overwrite(mailbox_t *mbx, const void *data);
+result_t mailbox_read(mailbox_t *mbx, void *data, mailbox_version_t *version);
+mailbox_version_t mailbox_get_version(mailbox_t *mbx);
+void mailbox_suspend(mailbox_t *mbx, mailbox_version_t version, tick_t ticks_to_delay);
+result_t mailbox_read_suspend(mailbox_t *mbx, void *data, mailbox_version_t *version, tick_t ticks_to_delay);
+
+void stream_buffer_init(stream_buffer_t *stm, void *buff, queue_size_t buff_size, queue_size_t trigger);
+queue_size_t stream_buffer_read(stream_buffer_t *stm, void *data, queue_size_t size);
+queue_size_t stream_buffer_write(stream_buffer_t *stm, const void *data, queue_size_t size);
+queue_size_t stream_buffer_get_num_used(stream_buffer_t *stm);
+queue_size_t stream_buffer_get_num_free(stream_buffer_t *stm);
+void stream_buffer_suspend(stream_buffer_t *stm, tick_t ticks_to_delay);
+queue_size_t stream_buffer_read_suspend(stream_buffer_t *stm, void *data, queue_size_t size, tick_t ticks_to_delay);
+
+void message_buffer_init(message_buffer_t *msg, void *buff, queue_size_t buff_size);
+item_size_t message_buffer_read(message_buffer_t *msg, void *data, item_size_t size);
+result_t message_buffer_write(message_buffer_t *msg, const void *data, item_size_t size);
+uint8_t message_buffer_is_empty(message_buffer_t *msg);
+item_size_t message_buffer_get_next_length(message_buffer_t *msg);
+void message_buffer_suspend(message_buffer_t *msg, tick_t ticks_to_delay);
+item_size_t message_buffer_read_suspend(message_buffer_t *msg, void *data, item_size_t size, tick_t ticks_to_delay);
+
+void topic_init(topic_t *top, void *buff, queue_size_t que_size, item_size_t item_size);
+void topic_subscribe(topic_t *top, subscriber_t *sub);
+void topic_unsubscribe(subscriber_t *sub);
+void topic_publish(topic_t *top, const void *data);
+result_t topic_read(subscriber_t *sub, void *data);
+topic_seq_t topic_get_num_skipped(subscriber_t *sub);
+void topic_suspend(subscriber_t *sub, tick_t ticks_to_delay);
+result_t topic_read_suspend(subscriber_t *sub, void *data, tick_t ticks_to_delay);
+
+void channel_init(channel_t *chan, item_size_t item_size);
+result_t channel_read(channel_t *chan, void *data);
+result_t channel_write(channel_t *chan, const void *data);
+result_t channel_read_suspend(channel_t *chan, void *data, tick_t ticks_to_delay);
+result_t channel_write_suspend(channel_t *chan, const void *data, tick_t ticks_to_delay);
+
+void event_group_init(event_group_t *grp);
+void event_group_set(event_group_t *grp, event_bits_t bits);
+event_bits_t event_group_clear(event_group_t *grp, event_bits_t bits);
+event_bits_t event_group_get(event_group_t *grp);
+event_bits_t event_group_wait(event_group_t *grp, event_bits_t mask, uint8_t wait_all, uint8_t clear_on_exit, tick_t ticks_to_delay);
+
+void barrier_init(barrier_t *bar, sem_count_t parties);
+result_t barrier_wait(barrier_t *bar, tick_t ticks_to_delay);
+sem_count_t barrier_get_num_arrived(barrier_t *bar);
+
+void latch_init(latch_t *lat, sem_count_t count);
+void latch_count_down(latch_t *lat);
+sem_count_t latch_get_count(latch_t *lat);
+result_t latch_wait(latch_t *lat, tick_t ticks_to_delay);
 
 /**
  * Run block periodically, every 'delay_ticks' ticks.
@@ -207,10 +682,10 @@ typedef struct {
     tick_t tick;
     task_t *current_task;
     struct list_t tasks_ready[NUM_PRIORITIES];
+    struct priority_bitmap_t priorities_ready;
     struct list_t tasks_suspended;
-    struct list_t *tasks_delayed_current;
-    struct list_t *tasks_delayed_overflow;
-    struct list_t tasks_delayed[2];
+    struct list_t tasks_delayed[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SIZE];
+    uint16_t delayed_buckets[TIMING_WHEEL_LEVELS]; /* Non-empty buckets. */
 } librertos_t;
 
 extern librertos_t librertos;
@@ -228,10 +703,17 @@ void list_remove(struct node_t *node);
 struct node_t *list_get_first(struct list_t *list);
 uint8_t list_is_empty(struct list_t *list);
 
+void priority_bitmap_init(struct priority_bitmap_t *bitmap);
+void priority_bitmap_set(struct priority_bitmap_t *bitmap, int8_t priority);
+void priority_bitmap_clear(struct priority_bitmap_t *bitmap, int8_t priority);
+int8_t priority_bitmap_get_highest(struct priority_bitmap_t *bitmap);
+
 void event_init(event_t *event);
+void event_set_policy(event_t *event, event_policy_t policy);
 void event_add_task_to_event(event_t *event);
 void event_delay_task(event_t *event, tick_t ticks_to_delay);
-void event_resume_task(event_t *event);
+result_t event_resume_task(event_t *event);
+void event_resume_all(event_t *event);
 
 #endif /* LIBRERTOS_DEBUG_DECLARATIONS */
 
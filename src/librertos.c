@@ -10,16 +10,65 @@
     #define LIBRERTOS_DISABLE_TIMERS 0 /* Enabled by default. */
 #endif
 
-#ifndef LIBRERTOS_DISABLE_SEMAPHORES
-    #define LIBRERTOS_DISABLE_SEMAPHORES 0 /* Enabled by default. */
+#ifndef LIBRERTOS_DISABLE_CONDVARS
+    #define LIBRERTOS_DISABLE_CONDVARS 0 /* Enabled by default. */
 #endif
 
-#ifndef LIBRERTOS_DISABLE_MUTEXES
-    #define LIBRERTOS_DISABLE_MUTEXES 0 /* Enabled by default. */
+#ifndef LIBRERTOS_DISABLE_SPSC_QUEUES
+    #define LIBRERTOS_DISABLE_SPSC_QUEUES 0 /* Enabled by default. */
 #endif
 
-#ifndef LIBRERTOS_DISABLE_QUEUES
-    #define LIBRERTOS_DISABLE_QUEUES 0 /* Enabled by default. */
+#ifndef LIBRERTOS_DISABLE_MAILBOXES
+    #define LIBRERTOS_DISABLE_MAILBOXES 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_STREAM_BUFFERS
+    #define LIBRERTOS_DISABLE_STREAM_BUFFERS 0 /* Enabled by default. */
+#endif
+
+#ifndef LIBRERTOS_DISABLE_TOPICS
+    #define LIBRERTOS_DISABLE_TOPICS 0 /* Enabled by default. */
+#endif
+
+/* Condition variables are bound to a mutex. */
+#if (LIBRERTOS_DISABLE_MUTEXES != 0)
+    #undef LIBRERTOS_DISABLE_CONDVARS
+    #define LIBRERTOS_DISABLE_CONDVARS 1
+#endif
+
+/* Maximum number of mutexes a priority boost crosses when the owner of a
+ * mutex waits for another mutex. The project can define it.
+ */
+#ifndef MUTEX_INHERITANCE_DEPTH
+    #define MUTEX_INHERITANCE_DEPTH 8
+#endif
+
+/* Memory barriers for the lock-free SPSC queue. The port can define them.
+ * PORT_MEMORY_BARRIER() is a full barrier, PORT_ACQUIRE_BARRIER() orders
+ * a read before the following accesses and PORT_RELEASE_BARRIER() orders the
+ * previous accesses before a write.
+ */
+#if defined(__STDC_VERSION__) && !defined(__STDC_NO_ATOMICS__)
+    #if (__STDC_VERSION__ >= 201112L)
+        #include <stdatomic.h>
+        #ifndef PORT_MEMORY_BARRIER
+            #define PORT_MEMORY_BARRIER() atomic_thread_fence(memory_order_seq_cst)
+            #define PORT_ACQUIRE_BARRIER() atomic_thread_fence(memory_order_acquire)
+            #define PORT_RELEASE_BARRIER() atomic_thread_fence(memory_order_release)
+        #endif
+    #endif
+#endif
+#if !defined(PORT_MEMORY_BARRIER) && defined(__GNUC__)
+    #define PORT_MEMORY_BARRIER() __sync_synchronize()
+#endif
+#ifndef PORT_ACQUIRE_BARRIER
+    #define PORT_ACQUIRE_BARRIER() PORT_MEMORY_BARRIER()
+#endif
+#ifndef PORT_RELEASE_BARRIER
+    #define PORT_RELEASE_BARRIER() PORT_MEMORY_BARRIER()
+#endif
+#if !defined(PORT_MEMORY_BARRIER) && (LIBRERTOS_DISABLE_SPSC_QUEUES == 0)
+    #error "Define PORT_MEMORY_BARRIER() in librertos_port.h for the SPSC queue."
 #endif
 
 #define NONZERO_INITVAL 0x5A
@@ -31,7 +80,10 @@
 enum {
     MUTEX_UNLOCKED = 0,
     TASK_NOT_RUNNING = 0,
-    TASK_RUNNING = 1
+    TASK_RUNNING = 1,
+    NOTIFY_STATE_NONE = 0,
+    NOTIFY_STATE_WAITING = 1,
+    NOTIFY_STATE_PENDING = 2
 };
 
 /*
@@ -66,6 +118,7 @@ librertos_t librertos;
  */
 void librertos_init(void) {
     int8_t i;
+    uint8_t j;
     CRITICAL_VAL();
 
     LIBRERTOS_ASSERT((tick_t)-1 > 0, "tick_t must be an unsigned integer.");
@@ -88,13 +141,15 @@ void librertos_init(void) {
 
     for (i = 0; i < NUM_PRIORITIES; ++i)
         list_init(&librertos.tasks_ready[i]);
+    priority_bitmap_init(&librertos.priorities_ready);
 
     list_init(&librertos.tasks_suspended);
-    librertos.tasks_delayed_current = &librertos.tasks_delayed[0];
-    librertos.tasks_delayed_overflow = &librertos.tasks_delayed[1];
 
-    list_init(&librertos.tasks_delayed[0]);
-    list_init(&librertos.tasks_delayed[1]);
+    for (i = 0; i < TIMING_WHEEL_LEVELS; ++i) {
+        for (j = 0; j < TIMING_WHEEL_SIZE; ++j)
+            list_init(&librertos.tasks_delayed[i][j]);
+        librertos.delayed_buckets[i] = 0;
+    }
 
     CRITICAL_EXIT();
 }
@@ -135,6 +190,32 @@ void librertos_create_task(
     task->delay_until = 0;
     node_init(&task->sched_node, task);
     node_init(&task->event_node, task);
+    task->event = NULL;
+#if (LIBRERTOS_DISABLE_QUEUES == 0 || LIBRERTOS_DISABLE_CHANNELS == 0)
+    task->handoff_data = NULL;
+#endif
+    task->wake_result = TASK_WAKE_NONE;
+#if (LIBRERTOS_DISABLE_SEMAPHORES == 0)
+    task->wait_count = 0;
+#endif
+#if (LIBRERTOS_DISABLE_MUTEXES == 0)
+    task->held_mutexes = NULL;
+    task->blocked_mutex = NULL;
+#endif
+#if (LIBRERTOS_DISABLE_RWLOCKS == 0)
+    task->held_rwlocks = NULL;
+#endif
+#if (LIBRERTOS_DISABLE_TASK_NOTIFICATIONS == 0)
+    task->notify_value = 0;
+    task->notify_state = NOTIFY_STATE_NONE;
+#endif
+#if (LIBRERTOS_DISABLE_EVENT_GROUPS == 0)
+    task->wait_bits = 0;
+    task->wait_flags = 0;
+#endif
+#if (LIBRERTOS_DISABLE_BARRIERS == 0)
+    task->barrier_generation = 0;
+#endif
 
     scheduler_lock();
     CRITICAL_ENTER();
@@ -164,6 +245,9 @@ void librertos_start(void) {
  * Get the highest priority task that is ready to be scheduled. Return NULL
  * if there is no task ready with higher priority than the current task.
  *
+ * The highest non-empty ready list is found with the ready-priority bitmap,
+ * so this takes constant time regardless of NUM_PRIORITIES.
+ *
  * Call with interrupts disabled.
  *
  * @param current_task Pointer to the current task.
@@ -173,25 +257,22 @@ static task_t *get_higher_priority_task(task_t *current_task) {
     struct node_t *node;
     task_t *task;
     int8_t current_priority = (current_task != NULL) ? current_task->priority : -1;
-    int8_t i;
+    int8_t i = priority_bitmap_get_highest(&librertos.priorities_ready);
 
-    for (i = HIGH_PRIORITY; i > current_priority; --i) {
-        if (list_is_empty(&librertos.tasks_ready[i]))
-            continue;
-
-        node = list_get_first(&librertos.tasks_ready[i]);
-        task = (task_t *)node->owner;
+    /* No task ready (i = -1) or no task with higher priority. */
+    if (i <= current_priority)
+        return NULL;
 
-        if (task->task_state == TASK_RUNNING)
-            break;
+    node = list_get_first(&librertos.tasks_ready[i]);
+    task = (task_t *)node->owner;
 
-        list_remove(node);
-        list_insert_last(&librertos.tasks_ready[i], node);
+    if (task->task_state == TASK_RUNNING)
+        return NULL;
 
-        return task;
-    }
+    list_remove(node);
+    list_insert_last(&librertos.tasks_ready[i], node);
 
-    return NULL;
+    return task;
 }
 
 /**
@@ -350,38 +431,404 @@ void interrupt_unlock(task_t *interrupted_task) {
     scheduler_unlock();
 }
 
-/* Call with interrupts disabled and scheduler locked. */
-static void swap_lists_of_delayed_tasks(void) {
-    struct list_t *temp = librertos.tasks_delayed_overflow;
-    librertos.tasks_delayed_overflow = librertos.tasks_delayed_current;
-    librertos.tasks_delayed_current = temp;
+#ifndef PORT_FIND_LAST_SET
+    /* Portable fallback, the port can define a faster one (ex: with a count
+     * leading zeros instruction).
+     */
+    #define PORT_FIND_LAST_SET(word) find_last_set(word)
+
+/* Get the index of the most significant bit set in a non-zero word. Binary
+ * search, constant time.
+ */
+static uint8_t find_last_set(uint16_t word) {
+    uint8_t bit = 0;
+
+    if (word & 0xFF00U) {
+        word >>= 8;
+        bit += 8;
+    }
+    if (word & 0x00F0U) {
+        word >>= 4;
+        bit += 4;
+    }
+    if (word & 0x000CU) {
+        word >>= 2;
+        bit += 2;
+    }
+    if (word & 0x0002U) {
+        bit += 1;
+    }
+
+    return bit;
 }
+#endif /* PORT_FIND_LAST_SET */
 
-/* Call with interrupts disabled and scheduler locked. */
-static void resume_list_of_tasks(struct list_t *list, tick_t now) {
-    INTERRUPTS_VAL();
+/* Clear the bit of a timing wheel bucket that became empty. Other lists are
+ * ignored.
+ * Call with interrupts disabled.
+ */
+static void delay_clear_bucket(struct list_t *list) {
+    struct list_t *first = &librertos.tasks_delayed[0][0];
 
-    while (list->length != 0) {
-        struct node_t *node = list_get_first(list);
+    if (list >= first && list < first + TIMING_WHEEL_LEVELS * TIMING_WHEEL_SIZE) {
+        uint16_t index = (uint16_t)(list - first);
+        librertos.delayed_buckets[index / TIMING_WHEEL_SIZE] &=
+            (uint16_t)~(1U << (index % TIMING_WHEEL_SIZE));
+    }
+}
+
+/* Call with interrupts disabled. */
+static void task_remove_from_sched_list(task_t *task) {
+    struct list_t *list = task->sched_node.list;
+
+    list_remove(&task->sched_node);
+
+    if (!list_is_empty(list)) {
+        /* Other tasks remain. */
+    } else if (list == &librertos.tasks_ready[task->priority]) {
+        priority_bitmap_clear(&librertos.priorities_ready, task->priority);
+    } else {
+        delay_clear_bucket(list);
+    }
+}
+
+/* Call with interrupts disabled. */
+static void task_insert_in_ready_list(task_t *task) {
+    list_insert_last(&librertos.tasks_ready[task->priority], &task->sched_node);
+    priority_bitmap_set(&librertos.priorities_ready, task->priority);
+}
+
+/* Call with interrupts disabled. */
+static void task_remove_from_event(task_t *task) {
+    event_t *event = task->event;
+    struct list_t *list = task->event_node.list;
+
+    list_remove(&task->event_node);
+
+    if (list_is_empty(list))
+        priority_bitmap_clear(&event->priorities, (int8_t)(list - event->suspended_tasks));
+}
+
+/* Stop waiting for a notification when the task is resumed by a timeout or
+ * by task_resume(), so that a later notification does not resume it from an
+ * unrelated delay or suspension. task_notify() sets the state to pending
+ * before resuming the task.
+ *
+ * Call with interrupts disabled.
+ */
+static void task_stop_notify_wait(task_t *task) {
+#if (LIBRERTOS_DISABLE_TASK_NOTIFICATIONS == 0)
+    if (task->notify_state == NOTIFY_STATE_WAITING)
+        task->notify_state = NOTIFY_STATE_NONE;
+#else
+    (void)task;
+#endif
+}
+
+/*
+ * Move a task to its ready list and remove it from the event it waits for,
+ * recording why it was resumed. The scheduler runs it when unlocked, if it
+ * has a higher priority.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void task_make_ready(task_t *task, task_wake_t wake_result) {
+    int8_t current_priority;
+
+    task_remove_from_sched_list(task);
+    task_insert_in_ready_list(task);
+    task_stop_notify_wait(task);
+
+    if (node_in_list(&task->event_node)) {
+        task_remove_from_event(task);
+        task->wake_result = (uint8_t)wake_result;
+    }
+
+    /* Check if a higher priority task is ready. */
+    current_priority = (librertos.current_task != NULL) ? librertos.current_task->priority : -1;
+    if (task->priority > current_priority)
+        librertos.higher_priority_task_ready = 1;
+}
+
+/*
+ * Insert a task in the timing wheel bucket for its wakeup tick,
+ * task->delay_until, and mark the bucket as non-empty.
+ *
+ * The level is given by the most significant group of TIMING_WHEEL_BITS bits
+ * that differs between the wakeup tick and now, and the bucket is the value
+ * of that group in the wakeup tick. The bucket is processed when the tick counter
+ * reaches it, and then its tasks go to lower levels until level 0, where they
+ * are resumed.
+ *
+ * If tick_to_wakeup equals now the task wakes up after a full tick counter
+ * period, so it goes to the top level.
+ *
+ * Call with interrupts disabled.
+ */
+static void delay_insert_task(task_t *task, tick_t now) {
+    tick_t diff = task->delay_until ^ now;
+    uint8_t level = 0;
+    uint8_t bucket;
+
+    if (diff == 0) {
+        level = TIMING_WHEEL_LEVELS - 1;
+    } else {
+        while (diff >= TIMING_WHEEL_SIZE) {
+            diff >>= TIMING_WHEEL_BITS;
+            level++;
+        }
+    }
+
+    bucket = (uint8_t)((task->delay_until >> (level * TIMING_WHEEL_BITS)) & (TIMING_WHEEL_SIZE - 1));
+    list_insert_last(&librertos.tasks_delayed[level][bucket], &task->sched_node);
+    librertos.delayed_buckets[level] |= (uint16_t)(1U << bucket);
+}
+
+/* Link the chain of nodes first..last, which already point to the list, to
+ * the end of the list in one operation.
+ * Call with interrupts disabled.
+ */
+static void list_splice_last(
+    struct list_t *list, struct node_t *first, struct node_t *last, list_len_t length) {
+    first->prev = list->tail;
+    last->next = LIST_HEAD(list);
+    list->tail->next = first;
+    list->tail = last;
+    list->length = (list_len_t)(list->length + length);
+}
+
+/* Splice a run of expired tasks with the same priority onto their ready list.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void resume_run_of_tasks(struct node_t *first, struct node_t *last, list_len_t length) {
+    int8_t priority = ((task_t *)first->owner)->priority;
+    int8_t current_priority = (librertos.current_task != NULL) ? librertos.current_task->priority : -1;
+
+    list_splice_last(&librertos.tasks_ready[priority], first, last, length);
+    priority_bitmap_set(&librertos.priorities_ready, priority);
+
+    if (priority > current_priority)
+        librertos.higher_priority_task_ready = 1;
+}
+
+/* Process a bucket that expires now. The whole bucket is detached at once,
+ * the tasks that wake up now are spliced onto their ready lists in runs of
+ * the same priority and the others cascade to a lower level. The scheduler
+ * is locked by the tick interrupt, so the whole batch becomes ready without
+ * running any of them.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void resume_bucket_of_tasks(uint8_t level, uint8_t bucket, tick_t now) {
+    struct list_t *list = &librertos.tasks_delayed[level][bucket];
+    struct node_t *node = list_get_first(list);
+    struct node_t *end = LIST_HEAD(list);
+    struct node_t *first = NULL;
+    struct node_t *last = NULL;
+    list_len_t length = 0;
+
+    list_init(list);
+    librertos.delayed_buckets[level] &= (uint16_t)~(1U << bucket);
+
+    while (node != end) {
+        struct node_t *next = node->next;
         task_t *task = (task_t *)node->owner;
 
-        if (now < task->delay_until)
-            break;
+        if (first != NULL &&
+            (task->delay_until != now || task->priority != ((task_t *)first->owner)->priority)) {
+            resume_run_of_tasks(first, last, length);
+            first = NULL;
+        }
 
-        INTERRUPTS_ENABLE();
-        task_resume(task);
-        INTERRUPTS_DISABLE();
+        if (task->delay_until != now) {
+            /* Cascade to a lower level. */
+            delay_insert_task(task, now);
+        } else {
+            /* Expired, extend the run. */
+            node->list = &librertos.tasks_ready[task->priority];
+            if (first == NULL) {
+                first = node;
+                length = 0;
+            }
+            last = node;
+            length++;
+
+            task_stop_notify_wait(task);
+            if (node_in_list(&task->event_node)) {
+                task_remove_from_event(task);
+                task->wake_result = (uint8_t)TASK_WAKE_TIMED_OUT;
+            }
+        }
+
+        node = next;
     }
+
+    if (first != NULL)
+        resume_run_of_tasks(first, last, length);
 }
 
-/* Call with interrupts disabled and scheduler locked. */
+/* Process the buckets of the timing wheel that expire now. A bucket of a
+ * level above 0 expires when all the lower bits of the tick counter wrap to
+ * zero. Higher levels are processed first, so that their tasks cascade into
+ * the lower level buckets that expire in the same tick.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
 static void resume_delayed_tasks(tick_t now) {
-    if (now == 0) {
-        /* Tick overflow. */
-        swap_lists_of_delayed_tasks();
-        resume_list_of_tasks(librertos.tasks_delayed_overflow, MAX_DELAY);
+    uint8_t level = 0;
+
+    while (level + 1 < TIMING_WHEEL_LEVELS &&
+           (now & (((tick_t)1 << ((level + 1) * TIMING_WHEEL_BITS)) - 1)) == 0)
+        level++;
+
+    do {
+        uint8_t bucket = (uint8_t)((now >> (level * TIMING_WHEEL_BITS)) & (TIMING_WHEEL_SIZE - 1));
+
+        if (librertos.delayed_buckets[level] & (1U << bucket))
+            resume_bucket_of_tasks(level, bucket, now);
+    } while (level-- != 0);
+}
+
+/* Get the first bucket of the level in bits processed after now, in
+ * circular order starting after the current bucket. bits must not be zero.
+ *
+ * Call with interrupts disabled.
+ */
+static uint8_t delay_get_next_bucket(uint16_t bits, uint8_t level, tick_t now) {
+    uint8_t start = (uint8_t)(((now >> (level * TIMING_WHEEL_BITS)) + 1) & (TIMING_WHEEL_SIZE - 1));
+
+    /* Rotate the bitmap so it starts after the current bucket and take the
+     * lowest bit set.
+     */
+    if (start != 0)
+        bits = (uint16_t)(((bits >> start) | (bits << (TIMING_WHEEL_SIZE - start))) &
+                          TIMING_WHEEL_MASK);
+
+    return (uint8_t)((start + PORT_FIND_LAST_SET((uint16_t)(bits & (0U - bits)))) &
+                     (TIMING_WHEEL_SIZE - 1));
+}
+
+/* Get the number of ticks until the bucket of the level is processed.
+ * Call with interrupts disabled.
+ */
+static tick_t delay_get_ticks_to_bucket(uint8_t level, uint8_t bucket, tick_t now) {
+    /* Mask of the bits of this level and the lower levels. */
+    tick_t mask = (level + 1 < TIMING_WHEEL_LEVELS)
+                      ? (((tick_t)1 << ((level + 1) * TIMING_WHEEL_BITS)) - 1)
+                      : MAX_DELAY;
+    tick_t ticks = (((tick_t)bucket << (level * TIMING_WHEEL_BITS)) - now) & mask;
+
+    if (ticks == 0) {
+        /* Processed now, the next time is a whole level later. */
+        ticks = (mask != MAX_DELAY) ? mask + 1 : MAX_DELAY;
+    }
+
+    return ticks;
+}
+
+/*
+ * Get the number of ticks until the next tick that processes a non-empty
+ * bucket of the timing wheel. That tick is not later than the earliest
+ * wakeup of the delayed tasks, and no delayed task wakes up before it.
+ * Return 0 if there are no delayed tasks.
+ *
+ * Checks one bucket per level, the first non-empty bucket after the current
+ * one in the bitmap of the level.
+ *
+ * Call with interrupts disabled.
+ */
+static tick_t delay_get_ticks_to_next_bucket(tick_t now) {
+    tick_t min_ticks = 0;
+    uint8_t level;
+
+    for (level = 0; level < TIMING_WHEEL_LEVELS; ++level) {
+        uint16_t bits = librertos.delayed_buckets[level];
+        tick_t ticks;
+
+        if (bits == 0)
+            continue;
+
+        ticks = delay_get_ticks_to_bucket(level, delay_get_next_bucket(bits, level, now), now);
+
+        if (min_ticks == 0 || ticks < min_ticks)
+            min_ticks = ticks;
+    }
+
+    return min_ticks;
+}
+
+/*
+ * Get the number of ticks until the earliest wakeup of the delayed tasks.
+ * Return 0 if there are no delayed tasks.
+ *
+ * A task wakes up no earlier than the next processing of its bucket. The
+ * buckets of each level are checked in the order they are processed, until
+ * one is processed after the earliest wakeup found. A task whose wakeup wraps
+ * around the tick counter can sit in an early bucket, so the first bucket of
+ * a level does not always hold its earliest wakeup.
+ *
+ * Call with interrupts disabled.
+ */
+static tick_t delay_get_ticks_to_next_wakeup(tick_t now) {
+    tick_t min_ticks = 0;
+    uint8_t level;
+
+    for (level = 0; level < TIMING_WHEEL_LEVELS; ++level) {
+        uint16_t bits = librertos.delayed_buckets[level];
+
+        while (bits != 0) {
+            uint8_t bucket = delay_get_next_bucket(bits, level, now);
+            struct list_t *list = &librertos.tasks_delayed[level][bucket];
+            struct node_t *node;
+
+            if (min_ticks != 0 && delay_get_ticks_to_bucket(level, bucket, now) >= min_ticks)
+                break;
+
+            for (node = list_get_first(list); node != LIST_HEAD(list); node = node->next) {
+                tick_t ticks = ((task_t *)node->owner)->delay_until - now;
+
+                /* Waking up now means a whole tick counter period later. */
+                if (ticks == 0)
+                    ticks = MAX_DELAY;
+
+                if (min_ticks == 0 || ticks < min_ticks)
+                    min_ticks = ticks;
+            }
+
+            bits &= (uint16_t)~(1U << bucket);
+        }
+    }
+
+    return min_ticks;
+}
+
+/**
+ * Get the tick of the next wakeup of the delayed tasks (and timers).
+ *
+ * Used for tickless idle: the port can stop the tick interrupt until this
+ * tick, sleep, and then call librertos_tick_advance() with the elapsed ticks,
+ * which moves the tasks through the timing wheel levels on the way there.
+ * The tick is the earliest wakeup of a task, so an idle kernel takes no
+ * other timer wakeups.
+ *
+ * @param wakeup_tick Pointer to store the tick of the next wakeup.
+ * @return 1 if there is a delayed task, 0 otherwise (sleep until another
+ * interrupt).
+ */
+result_t get_next_wakeup(tick_t *wakeup_tick) {
+    result_t result = LIBRERTOS_FAIL;
+    tick_t ticks;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    ticks = delay_get_ticks_to_next_wakeup(librertos.tick);
+    if (ticks != 0) {
+        *wakeup_tick = librertos.tick + ticks;
+        result = LIBRERTOS_SUCCESS;
     }
-    resume_list_of_tasks(librertos.tasks_delayed_current, now);
+
+    CRITICAL_EXIT();
+    return result;
 }
 
 /**
@@ -419,6 +866,51 @@ void librertos_tick_interrupt(void) {
     CRITICAL_EXIT();
 }
 
+/**
+ * Advance the tick counter by a number of ticks and resume the delayed tasks
+ * that expired, as if librertos_tick_interrupt() was called that number of
+ * times.
+ *
+ * Used to catch up after a tickless idle sleep or a late tick interrupt.
+ * Ticks in which no delayed task could expire are skipped at once.
+ *
+ * Must lock the scheduler for interrupts before calling and unlock after
+ * it returns.
+ *
+ * Example:
+ *
+ * ```cpp
+ * void Timer0_IRQ(void) {
+ *     task_t *interrupted_task = interrupt_lock();
+ *     librertos_tick_advance(port_get_elapsed_ticks());
+ *     interrupt_unlock(interrupted_task);
+ * }
+ * ```
+ *
+ * @param ticks Number of ticks elapsed.
+ */
+void librertos_tick_advance(tick_t ticks) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.scheduler_depth > 0, "Cannot process tick when the scheduler is unlocked.");
+
+    CRITICAL_ENTER();
+    while (ticks != 0) {
+        tick_t skip = delay_get_ticks_to_next_bucket(librertos.tick);
+
+        if (skip == 0 || skip > ticks) {
+            /* No delayed task expires in the remaining ticks. */
+            librertos.tick += ticks;
+            break;
+        }
+
+        librertos.tick += skip;
+        ticks -= skip;
+        resume_delayed_tasks(librertos.tick);
+    }
+    CRITICAL_EXIT();
+}
+
 /**
  * Get the tick counter, the number of ticks since initialization.
  *
@@ -462,54 +954,9 @@ void set_current_task(task_t *task) {
     CRITICAL_EXIT();
 }
 
-/* Call with interrupts disabled and scheduler locked. */
-static struct node_t *delay_find_tick_position(struct list_t *list, tick_t tick) {
-    struct node_t *head = LIST_HEAD(list);
-    struct node_t *pos;
-    INTERRUPTS_VAL();
-
-    do {
-        pos = list->head;
-
-        while (pos != head) {
-            task_t *task = (task_t *)pos->owner;
-            tick_t pos_tick = task->delay_until;
-
-            INTERRUPTS_ENABLE();
-
-            /* Compare outside of critical section. */
-            if (tick < pos_tick) {
-                /* Found the position: before pos. Stop. */
-                INTERRUPTS_DISABLE();
-                break;
-            }
-
-            INTERRUPTS_DISABLE();
-
-            if (pos->list != list) {
-                /* Restart if pos was removed from the list during the
-                 * comparison.
-                 */
-                break;
-            }
-
-            /* This is not the correct position. Continue. */
-            pos = pos->next;
-        }
-
-        /* Restart if pos was removed from the list during the comparison. */
-    } while (pos != head && pos->list != list);
-
-    pos = pos->prev;
-    return pos;
-}
-
 /* Must be called by a task. No other restrictions when calling. */
 static void task_delay_now_until(tick_t now, tick_t tick_to_wakeup) {
     task_t *task;
-    struct node_t *node;
-    struct node_t *pos;
-    struct list_t *delay_list;
     CRITICAL_VAL();
 
     scheduler_lock();
@@ -518,22 +965,20 @@ static void task_delay_now_until(tick_t now, tick_t tick_to_wakeup) {
     LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
 
     task = librertos.current_task;
-    node = &task->sched_node;
-    task->delay_until = tick_to_wakeup;
-    delay_list = (now < tick_to_wakeup) ? librertos.tasks_delayed_current
-                                        : librertos.tasks_delayed_overflow;
 
-    /* Suspend the task so that it can be resumed. */
-    task_suspend(task);
+    if (tick_to_wakeup != now &&
+        (tick_t)(librertos.tick - now) >= (tick_t)(tick_to_wakeup - now)) {
+        /* The tick counter already reached the wakeup tick after 'now' was
+         * read. Wake up in the next tick.
+         */
+        tick_to_wakeup = librertos.tick + 1;
+    }
 
-    pos = delay_find_tick_position(delay_list, tick_to_wakeup);
+    task->delay_until = tick_to_wakeup;
 
-    /* Check if current task was not resumed. */
-    if (node->list == &librertos.tasks_suspended) {
-        /* Update the position. */
-        list_remove(node);
-        list_insert_after(delay_list, pos, node);
-    }
+    /* Insert the task in its timing wheel bucket, constant time. */
+    task_remove_from_sched_list(task);
+    delay_insert_task(task, librertos.tick);
 
     CRITICAL_EXIT();
     scheduler_unlock();
@@ -575,7 +1020,7 @@ void task_suspend(task_t *task) {
     if (task == NULL)
         task = librertos.current_task;
 
-    list_remove(&task->sched_node);
+    task_remove_from_sched_list(task);
     list_insert_first(&librertos.tasks_suspended, &task->sched_node);
 
     CRITICAL_EXIT();
@@ -587,22 +1032,12 @@ void task_suspend(task_t *task) {
  * @param task Task to resume.
  */
 void task_resume(task_t *task) {
-    int8_t current_priority;
     CRITICAL_VAL();
 
     scheduler_lock();
     CRITICAL_ENTER();
 
-    list_remove(&task->sched_node);
-    list_insert_last(&librertos.tasks_ready[task->priority], &task->sched_node);
-
-    if (node_in_list(&task->event_node))
-        list_remove(&task->event_node);
-
-    /* Check if a higher priority task is ready. */
-    current_priority = (librertos.current_task != NULL) ? librertos.current_task->priority : -1;
-    if (task->priority > current_priority)
-        librertos.higher_priority_task_ready = 1;
+    task_make_ready(task, TASK_WAKE_RESUMED);
 
     /* The scheduler is locked and unlocked only if a task was actually
      * resumed. When the scheduler unlocks the current task can be preempted
@@ -612,19 +1047,141 @@ void task_resume(task_t *task) {
     scheduler_unlock();
 }
 
-#if (LIBRERTOS_DISABLE_TIMERS == 0)
+/**
+ * Get why the task was resumed the last time it waited for an event.
+ *
+ * Pass a NULL pointer to get it for the current task.
+ *
+ * @param task Task to check.
+ * @return TASK_WAKE_ACQUIRED if an unlock or write granted it the resource,
+ * TASK_WAKE_TIMED_OUT if the ticks to delay passed, TASK_WAKE_RESUMED if
+ * resumed by the event or by task_resume() and TASK_WAKE_NONE if still
+ * waiting or it never waited.
+ */
+task_wake_t task_get_wake_result(task_t *task) {
+    task_wake_t value;
+    CRITICAL_VAL();
 
-/* Call with interrupts disabled. */
-static int8_t timer_is_reset(timer_task_t *timer) {
-    return (timer->timer_task.sched_node.list == &librertos.tasks_delayed[0] ||
-            timer->timer_task.sched_node.list == &librertos.tasks_delayed[1]);
+    LIBRERTOS_ASSERT(task != NULL || librertos.current_task != NULL, "Cannot get the wake result without a task.");
+
+    CRITICAL_ENTER();
+
+    if (task == NULL)
+        task = librertos.current_task;
+
+    value = (task_wake_t)task->wake_result;
+
+    CRITICAL_EXIT();
+    return value;
+}
+
+#if (LIBRERTOS_DISABLE_TASK_NOTIFICATIONS == 0)
+
+/**
+ * Notify the task, changing its notification value, and resume it if it is
+ * waiting in task_notify_wait().
+ *
+ * Takes constant time and uses no event list. Can be used by tasks and
+ * interrupts.
+ *
+ * @param task Task to notify.
+ * @param action NOTIFY_SET_BITS, NOTIFY_INCREMENT or NOTIFY_OVERWRITE.
+ * @param bits Bits to set or value to overwrite.
+ */
+void task_notify(task_t *task, notify_action_t action, notify_value_t bits) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    switch (action) {
+    case NOTIFY_SET_BITS:
+        task->notify_value |= bits;
+        break;
+    case NOTIFY_INCREMENT:
+        task->notify_value++;
+        break;
+    default:
+        task->notify_value = bits;
+        break;
+    }
+
+    if (task->notify_state == NOTIFY_STATE_WAITING) {
+        scheduler_lock();
+        task->notify_state = NOTIFY_STATE_PENDING;
+        task_make_ready(task, TASK_WAKE_RESUMED);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        task->notify_state = NOTIFY_STATE_PENDING;
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Get the notification value of the current task if it was notified, else
+ * suspend the task waiting to be notified, waiting a maximum number for
+ * ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param clear_bits Bits to clear from the notification value after getting
+ * it. Pass (notify_value_t)-1 to clear it.
+ * @param value Pointer to receive the notification value, or NULL.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 if notified, 0 otherwise.
+ */
+result_t task_notify_wait(notify_value_t clear_bits, notify_value_t *value, tick_t ticks_to_delay) {
+    result_t result = LIBRERTOS_FAIL;
+    task_t *task = librertos.current_task;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+
+    if (task->notify_state == NOTIFY_STATE_PENDING) {
+        if (value != NULL)
+            *value = task->notify_value;
+        task->notify_value &= (notify_value_t)~clear_bits;
+        task->notify_state = NOTIFY_STATE_NONE;
+        result = LIBRERTOS_SUCCESS;
+        CRITICAL_EXIT();
+    } else {
+        scheduler_lock();
+
+        task->notify_state = NOTIFY_STATE_WAITING;
+        task_suspend(NULL);
+
+        if (ticks_to_delay != MAX_DELAY) {
+            tick_t now = get_tick();
+            task_delay_now_until(now, now + ticks_to_delay);
+        }
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    }
+
+    return result;
 }
 
+#endif /* LIBRERTOS_DISABLE_TASK_NOTIFICATIONS */
+
+#if (LIBRERTOS_DISABLE_TIMERS == 0)
+
 /* Call with interrupts disabled. */
 static int8_t timer_is_stopped(timer_task_t *timer) {
     return timer->timer_task.sched_node.list == &librertos.tasks_suspended;
 }
 
+/* Call with interrupts disabled. A timer is reset when its task is delayed,
+ * which means it is neither stopped (suspended) nor ready.
+ */
+static int8_t timer_is_reset(timer_task_t *timer) {
+    task_t *task = &timer->timer_task;
+    return (!timer_is_stopped(timer) &&
+            task->sched_node.list != &librertos.tasks_ready[task->priority]);
+}
+
 /* This function sets up the next state of the timer.
  * Call this function in the context of the timer task with the scheduler
  * locked.
@@ -842,14 +1399,17 @@ static void resume_list_of_tasks_not_timers(struct list_t *list) {
  * It does not resume any timers.
  */
 void task_resume_all(void) {
+    uint8_t i, j;
     CRITICAL_VAL();
 
     scheduler_lock();
     CRITICAL_ENTER();
 
     resume_list_of_tasks_not_timers(&librertos.tasks_suspended);
-    resume_list_of_tasks_not_timers(&librertos.tasks_delayed[0]);
-    resume_list_of_tasks_not_timers(&librertos.tasks_delayed[1]);
+
+    for (i = 0; i < TIMING_WHEEL_LEVELS; ++i)
+        for (j = 0; j < TIMING_WHEEL_SIZE; ++j)
+            resume_list_of_tasks_not_timers(&librertos.tasks_delayed[i][j]);
 
     CRITICAL_EXIT();
     scheduler_unlock();
@@ -883,7 +1443,7 @@ void list_insert_after(
     pos->next->prev = node;
     pos->next = node;
     node->list = list;
-    LIBRERTOS_ASSERT(list->length < 255, "List size overflow.");
+    LIBRERTOS_ASSERT(list->length != (list_len_t)-1, "List size overflow.");
     list->length++;
 }
 
@@ -919,84 +1479,122 @@ uint8_t list_is_empty(struct list_t *list) {
     return list->length == 0;
 }
 
-#if (LIBRERTOS_DISABLE_SEMAPHORES == 0 || LIBRERTOS_DISABLE_MUTEXES == 0 || \
-     LIBRERTOS_DISABLE_QUEUES == 0)
-
 /* Call with interrupts disabled. */
-void event_init(event_t *event) {
-    list_init(&event->suspended_tasks);
+void priority_bitmap_init(struct priority_bitmap_t *bitmap) {
+    uint8_t i;
+
+    bitmap->summary = 0;
+    for (i = 0; i < PRIORITY_BITMAP_WORDS; ++i)
+        bitmap->words[i] = 0;
 }
 
-/* Call with interrupts disabled and scheduler locked. */
-static struct node_t *
-event_find_priority_position(struct list_t *list, int8_t priority) {
-    struct node_t *head = LIST_HEAD(list);
-    struct node_t *pos;
-    INTERRUPTS_VAL();
+/* Call with interrupts disabled. */
+void priority_bitmap_set(struct priority_bitmap_t *bitmap, int8_t priority) {
+    uint8_t word = (uint8_t)priority / PRIORITY_BITMAP_BITS;
+    uint8_t bit = (uint8_t)priority % PRIORITY_BITMAP_BITS;
 
-    do {
-        pos = list->head;
+    bitmap->words[word] |= (uint16_t)(1U << bit);
+    bitmap->summary |= (uint16_t)(1U << word);
+}
 
-        while (pos != head) {
-            task_t *task = (task_t *)pos->owner;
-            int8_t pos_priority = task->priority;
+/* Call with interrupts disabled. */
+void priority_bitmap_clear(struct priority_bitmap_t *bitmap, int8_t priority) {
+    uint8_t word = (uint8_t)priority / PRIORITY_BITMAP_BITS;
+    uint8_t bit = (uint8_t)priority % PRIORITY_BITMAP_BITS;
 
-            INTERRUPTS_ENABLE();
+    bitmap->words[word] &= (uint16_t)~(1U << bit);
+    if (bitmap->words[word] == 0)
+        bitmap->summary &= (uint16_t)~(1U << word);
+}
 
-            /* Compare outside of critical section. */
-            if (priority > pos_priority) {
-                /* Found the position: before pos. Stop. */
-                INTERRUPTS_DISABLE();
-                break;
-            }
+/* Call with interrupts disabled. Return -1 if no bit is set. */
+int8_t priority_bitmap_get_highest(struct priority_bitmap_t *bitmap) {
+    uint8_t word;
 
-            INTERRUPTS_DISABLE();
+    if (bitmap->summary == 0)
+        return -1;
 
-            if (pos->list != list) {
-                /* Restart if pos was removed from the list during the
-                 * comparison.
-                 */
-                break;
-            }
+    word = (uint8_t)PORT_FIND_LAST_SET(bitmap->summary);
+    return (int8_t)(word * PRIORITY_BITMAP_BITS +
+                    PORT_FIND_LAST_SET(bitmap->words[word]));
+}
 
-            /* This is not the correct position. Continue. */
-            pos = pos->next;
-        }
+#if (LIBRERTOS_DISABLE_SEMAPHORES == 0 || LIBRERTOS_DISABLE_MUTEXES == 0 || \
+     LIBRERTOS_DISABLE_QUEUES == 0 || LIBRERTOS_DISABLE_SPSC_QUEUES == 0 || \
+     LIBRERTOS_DISABLE_MAILBOXES == 0 || LIBRERTOS_DISABLE_STREAM_BUFFERS == 0 || \
+     LIBRERTOS_DISABLE_TOPICS == 0 || LIBRERTOS_DISABLE_CHANNELS == 0 || \
+     LIBRERTOS_DISABLE_EVENT_GROUPS == 0 || LIBRERTOS_DISABLE_RWLOCKS == 0 || \
+     LIBRERTOS_DISABLE_CONDVARS == 0 || LIBRERTOS_DISABLE_BARRIERS == 0)
+
+/* Call with interrupts disabled. */
+void event_init(event_t *event) {
+    int8_t i;
 
-        /* Restart if pos was removed from the list during the comparison. */
-    } while (pos != head && pos->list != list);
+    for (i = 0; i < EVENT_PRIORITY_LISTS; ++i)
+        list_init(&event->suspended_tasks[i]);
+    priority_bitmap_init(&event->priorities);
+    event->policy = EVENT_POLICY;
+    event->handoff = EVENT_HANDOFF;
+}
 
-    pos = pos->prev;
+/* Call with interrupts disabled. */
+void event_set_policy(event_t *event, event_policy_t policy) {
+    event->policy = (uint8_t)policy;
+}
 
-    return pos;
+/* Call with interrupts disabled. */
+static int8_t event_get_list_index(event_t *event, task_t *task) {
+    if (event->policy == EVENT_POLICY_FIFO)
+        return 0;
+#if (EVENT_PRIORITY_LISTS == NUM_PRIORITIES)
+    return task->priority;
+#else
+    return (int8_t)((int16_t)task->priority * EVENT_PRIORITY_LISTS / NUM_PRIORITIES);
+#endif
 }
 
-/* Call with interrupts disabled and scheduler locked. */
+/*
+ * Add the current task to the event. With EVENT_POLICY_PRIORITY it goes to
+ * the list of its priority, with EVENT_POLICY_FIFO to the single list. The
+ * tasks in a list are resumed in FIFO order.
+ *
+ * If a list holds several priorities (EVENT_PRIORITY_LISTS < NUM_PRIORITIES),
+ * the task goes after the tasks with higher or equal priority in the list.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
 void event_add_task_to_event(event_t *event) {
     task_t *task = librertos.current_task;
-    int8_t task_priority = task->priority;
-    struct node_t *pos;
-
-    list_insert_last(&event->suspended_tasks, &task->event_node);
-
-    pos = event_find_priority_position(&event->suspended_tasks, task_priority);
-
-    /* Check if current task was not resumed. */
-    if (task->sched_node.list == &librertos.tasks_suspended) {
-        if (pos == &task->event_node) {
-            /* Already in the correct position. */
-        } else {
-            /* Update the position. */
-            list_remove(&task->event_node);
-            list_insert_after(&event->suspended_tasks, pos, &task->event_node);
-        }
+    int8_t i = event_get_list_index(event, task);
+    struct list_t *list = &event->suspended_tasks[i];
+    struct node_t *pos = list->tail;
+
+#if (EVENT_PRIORITY_LISTS != NUM_PRIORITIES)
+    if (event->policy == EVENT_POLICY_PRIORITY) {
+        while (pos != LIST_HEAD(list) && ((task_t *)pos->owner)->priority < task->priority)
+            pos = pos->prev;
     }
+#endif
+
+    list_insert_after(list, pos, &task->event_node);
+    priority_bitmap_set(&event->priorities, i);
+    task->event = event;
+    task->wake_result = TASK_WAKE_NONE;
 }
 
-/* Call with interrupts disabled and scheduler locked. */
+/*
+ * A task granted a resource by a handoff owns it until it takes it, retrying
+ * the same lock or read. Waiting for an event first would lose the resource,
+ * so it is not allowed.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
 void event_delay_task(event_t *event, tick_t ticks_to_delay) {
     LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
     LIBRERTOS_ASSERT(!node_in_list(&librertos.current_task->event_node), "This task is already suspended.");
+    LIBRERTOS_ASSERT(librertos.current_task->event == NULL ||
+                         librertos.current_task->wake_result != TASK_WAKE_ACQUIRED,
+        "Take the granted resource before waiting again.");
 
     /* Suspend the task and insert in the end of the list so that the event
      * can resume the task.
@@ -1012,143 +1610,195 @@ void event_delay_task(event_t *event, tick_t ticks_to_delay) {
     }
 }
 
-/* Call with interrupts disabled. */
-void event_resume_task(event_t *event) {
-    if (event->suspended_tasks.length != 0) {
-        task_t *task = (task_t *)list_get_first(&event->suspended_tasks)->owner;
+/* Get the task the event resumes next, NULL if none.
+ * Call with interrupts disabled.
+ */
+static task_t *event_get_first_task(event_t *event) {
+    int8_t priority = priority_bitmap_get_highest(&event->priorities);
+
+    if (priority >= 0)
+        return (task_t *)list_get_first(&event->suspended_tasks[priority])->owner;
+
+    return NULL;
+}
+
+/* Call with interrupts disabled. Return 1 if a task was resumed. */
+result_t event_resume_task(event_t *event) {
+    task_t *task = event_get_first_task(event);
+
+    if (task != NULL) {
         task_resume(task);
+        return LIBRERTOS_SUCCESS;
     }
+
+    return LIBRERTOS_FAIL;
 }
 
-#endif /* LIBRERTOS_DISABLE_SEMAPHORES || LIBRERTOS_DISABLE_MUTEXES || LIBRERTOS_DISABLE_QUEUES */
+/* Resume all tasks waiting for the event in one pass, higher priority first.
+ * Call with interrupts disabled and scheduler locked.
+ */
+void event_resume_all(event_t *event) {
+    int8_t priority;
 
-#if (LIBRERTOS_DISABLE_SEMAPHORES == 0)
+    while ((priority = priority_bitmap_get_highest(&event->priorities)) >= 0) {
+        struct list_t *list = &event->suspended_tasks[priority];
 
-/**
- * Initialize the semaphore with an initial value and a maximum value.
- *
- * It is recommended to use the functions below instead of this:
- * - semaphore_init_locked()
- * - semaphore_init_unlocked()
+        /* The bit is cleared when the last task of the list is removed. */
+        while (list->length != 0)
+            task_make_ready((task_t *)list_get_first(list)->owner, TASK_WAKE_RESUMED);
+    }
+}
+
+#if (LIBRERTOS_DISABLE_SEMAPHORES == 0 || LIBRERTOS_DISABLE_MUTEXES == 0 || \
+     LIBRERTOS_DISABLE_QUEUES == 0 || LIBRERTOS_DISABLE_CHANNELS == 0 || \
+     LIBRERTOS_DISABLE_EVENT_GROUPS == 0 || LIBRERTOS_DISABLE_BARRIERS == 0)
+
+/* Resume a task waiting for the event, granting it the resource.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void event_grant_task(task_t *task) {
+    task_make_ready(task, TASK_WAKE_ACQUIRED);
+}
+
+/* Take the resource granted to the current task by a handoff on the event.
+ * Return 1 if it was granted, only once per grant.
  *
- * @param init_count Initial value of the semaphore.
- * @param max_count Maximum value of the semaphore.
+ * Call with interrupts disabled.
  */
-void semaphore_init(semaphore_t *sem, uint8_t init_count, uint8_t max_count) {
-    CRITICAL_VAL();
+static result_t event_take_grant(event_t *event) {
+    task_t *task = librertos.current_task;
 
-    LIBRERTOS_ASSERT(init_count <= max_count, "Invalid init_count.");
+    if (task != NULL && task->event == event && task->wake_result == TASK_WAKE_ACQUIRED) {
+        task->event = NULL;
+        return LIBRERTOS_SUCCESS;
+    }
 
-    CRITICAL_ENTER();
+    return LIBRERTOS_FAIL;
+}
 
-    /* Make non-zero, to be easy to spot uninitialized fields. */
-    memset(sem, NONZERO_INITVAL, sizeof(*sem));
+#endif /* LIBRERTOS_DISABLE_SEMAPHORES || LIBRERTOS_DISABLE_MUTEXES || LIBRERTOS_DISABLE_QUEUES || LIBRERTOS_DISABLE_CHANNELS || LIBRERTOS_DISABLE_EVENT_GROUPS || LIBRERTOS_DISABLE_BARRIERS */
 
-    sem->count = init_count;
-    sem->max = max_count;
-    event_init(&sem->event_unlock);
+#endif /* LIBRERTOS_DISABLE_SEMAPHORES || LIBRERTOS_DISABLE_MUTEXES || LIBRERTOS_DISABLE_QUEUES || LIBRERTOS_DISABLE_SPSC_QUEUES || LIBRERTOS_DISABLE_MAILBOXES || LIBRERTOS_DISABLE_STREAM_BUFFERS || LIBRERTOS_DISABLE_TOPICS || LIBRERTOS_DISABLE_CHANNELS || LIBRERTOS_DISABLE_EVENT_GROUPS || LIBRERTOS_DISABLE_RWLOCKS || LIBRERTOS_DISABLE_CONDVARS || LIBRERTOS_DISABLE_BARRIERS */
 
-    CRITICAL_EXIT();
-}
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
 
 /**
- * Initialize the semaphore in the locked state (initial value equals zero).
+ * Initialize the queue set.
  *
- * @param max_count Maximum value of the semaphore.
+ * A task waits on the set for any of its member queues and semaphores,
+ * which are added with queue_set_add_queue() and queue_set_add_semaphore().
+ * Each item written to a member queue and each unit unlocked in a member
+ * semaphore writes a pointer to the member to the set, which resumes the
+ * task waiting on it in constant time. The task gets the member with
+ * queue_set_select() and then reads or locks it.
+ *
+ * The members must be read or locked only after being selected, one item or
+ * unit for each selection, so that the set always holds one pointer for each
+ * item or unit available. A selected queue is read with queue_read() or with
+ * queue_read_peek() and queue_read_release(), and queue_read_n() and
+ * semaphore_lock_n() cannot take more than one at once from a member.
+ *
+ * @param buff Pointer to a buffer with size set_size*sizeof(void *).
+ * @param set_size Number of pointers the set can hold, at least the sum of
+ * the sizes of the member queues and of the maximum values of the member
+ * semaphores.
  */
-void semaphore_init_locked(semaphore_t *sem, uint8_t max_count) {
-    semaphore_init(sem, 0, max_count);
+void queue_set_init(queue_set_t *set, void *buff, queue_size_t set_size) {
+    queue_init(&set->que, buff, set_size, sizeof(void *));
 }
 
-/**
- * Initialize semaphore in the unlocked state (initial value equals maximum
- * value).
- *
- * @param max_count Maximum value of the semaphore.
+/* Write the member to the set num times and resume waiting tasks.
+ * Call with interrupts disabled and scheduler locked.
  */
-void semaphore_init_unlocked(semaphore_t *sem, uint8_t max_count) {
-    semaphore_init(sem, max_count, max_count);
-}
+static void queue_set_post(queue_set_t *set, void *member, queue_size_t num) {
+    queue_t *que = &set->que;
 
-/* Call with interrupts disabled. */
-static uint8_t semaphore_can_be_locked(semaphore_t *sem) {
-    return sem->count > 0;
-}
+    LIBRERTOS_ASSERT(que->free >= num, "Queue set too small.");
 
-/* Call with interrupts disabled. */
-static uint8_t semaphore_can_be_unlocked(semaphore_t *sem) {
-    return sem->count < sem->max;
+    for (; num != 0; --num) {
+        memcpy(&que->buff[que->head], &member, sizeof(member));
+
+        que->head += que->item_size;
+        if (que->head >= que->end)
+            que->head = 0;
+
+        que->free--;
+        que->used++;
+
+        event_resume_task(&que->event_write);
+    }
 }
 
 /**
- * Lock the semaphore.
- *
- * @return 1 with success, 0 otherwise.
+ * Add an empty queue to the set. A queue can be in only one set.
  */
-result_t semaphore_lock(semaphore_t *sem) {
-    result_t result = LIBRERTOS_FAIL;
+void queue_set_add_queue(queue_set_t *set, queue_t *que) {
     CRITICAL_VAL();
-    CRITICAL_ENTER();
 
-    if (semaphore_can_be_locked(sem)) {
-        sem->count--;
-        result = LIBRERTOS_SUCCESS;
-    }
+    LIBRERTOS_ASSERT(que->set == NULL, "Already in a queue set.");
+    LIBRERTOS_ASSERT(que->used == 0, "Queue set member must be empty.");
 
+    CRITICAL_ENTER();
+    que->set = set;
     CRITICAL_EXIT();
-    return result;
 }
 
 /**
- * Unlock the semaphore.
- *
- * @return 1 with success, 0 otherwise.
+ * Add a locked semaphore to the set. A semaphore can be in only one set.
  */
-result_t semaphore_unlock(semaphore_t *sem) {
-    result_t result = LIBRERTOS_FAIL;
+void queue_set_add_semaphore(queue_set_t *set, semaphore_t *sem) {
     CRITICAL_VAL();
-    CRITICAL_ENTER();
 
-    if (semaphore_can_be_unlocked(sem)) {
-        scheduler_lock();
+    LIBRERTOS_ASSERT(sem->set == NULL, "Already in a queue set.");
+    LIBRERTOS_ASSERT(sem->count == 0, "Queue set member must be empty.");
 
-        sem->count++;
-        result = LIBRERTOS_SUCCESS;
+    CRITICAL_ENTER();
+    sem->set = set;
+    CRITICAL_EXIT();
+}
 
-        event_resume_task(&sem->event_unlock);
+/**
+ * Remove an empty queue from the set.
+ */
+void queue_set_remove_queue(queue_set_t *set, queue_t *que) {
+    CRITICAL_VAL();
 
-        CRITICAL_EXIT();
-        scheduler_unlock();
-    } else {
-        CRITICAL_EXIT();
-    }
+    LIBRERTOS_ASSERT(que->set == set, "Not in this queue set.");
+    LIBRERTOS_ASSERT(que->used == 0, "Queue set member must be empty.");
 
-    return result;
+    CRITICAL_ENTER();
+    que->set = NULL;
+    CRITICAL_EXIT();
 }
 
 /**
- * Get the current value of the semaphore.
+ * Remove a locked semaphore from the set.
  */
-uint8_t semaphore_get_count(semaphore_t *sem) {
-    uint8_t count;
+void queue_set_remove_semaphore(queue_set_t *set, semaphore_t *sem) {
     CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(sem->set == set, "Not in this queue set.");
+    LIBRERTOS_ASSERT(sem->count == 0, "Queue set member must be empty.");
+
     CRITICAL_ENTER();
-    count = sem->count;
+    sem->set = NULL;
     CRITICAL_EXIT();
-    return count;
 }
 
 /**
- * Get the maximum value of the semaphore.
+ * Get a member of the set that has an item to read or a unit to lock, in
+ * the order they became ready.
+ *
+ * @return Pointer to the queue or semaphore, NULL if none is ready.
  */
-uint8_t semaphore_get_max(semaphore_t *sem) {
-    /* Semaphore maximum value should not change.
-     * Critical section is not necessary. */
-    return sem->max;
+void *queue_set_select(queue_set_t *set) {
+    void *member = NULL;
+    (void)queue_read(&set->que, &member);
+    return member;
 }
 
 /**
- * Suspend the task on the semaphore, waiting a maximum number for ticks to pass
+ * Suspend the task on the set, waiting a maximum number for ticks to pass
  * before resuming.
  *
  * This function can be used only by tasks.
@@ -1156,417 +1806,3333 @@ uint8_t semaphore_get_max(semaphore_t *sem) {
  * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
  * MAX_DELAY to wait forever.
  */
-void semaphore_suspend(semaphore_t *sem, tick_t ticks_to_delay) {
-    CRITICAL_VAL();
-    CRITICAL_ENTER();
-
-    if (!semaphore_can_be_locked(sem)) {
-        scheduler_lock();
-        event_delay_task(&sem->event_unlock, ticks_to_delay);
-        CRITICAL_EXIT();
-        scheduler_unlock();
-    } else {
-        CRITICAL_EXIT();
-    }
+void queue_set_suspend(queue_set_t *set, tick_t ticks_to_delay) {
+    queue_suspend(&set->que, ticks_to_delay);
 }
 
 /**
- * Lock the semaphore if unlocked, else tries to suspend the task on the
- * semaphore, waiting a maximum number for ticks to pass before resuming.
+ * Get a member of the set that is ready, else tries to suspend the task on
+ * the set, waiting a maximum number for ticks to pass before resuming.
  *
  * This function can be used only by tasks.
  *
  * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
  * MAX_DELAY to wait forever.
- * @return 1 with success locking, 0 otherwise.
+ * @return Pointer to the queue or semaphore, NULL if none is ready.
  */
-result_t semaphore_lock_suspend(semaphore_t *sem, tick_t ticks_to_delay) {
-    result_t result = semaphore_lock(sem);
-    if (result == LIBRERTOS_FAIL)
-        semaphore_suspend(sem, ticks_to_delay);
-    return result;
+void *queue_set_select_suspend(queue_set_t *set, tick_t ticks_to_delay) {
+    void *member = queue_set_select(set);
+    if (member == NULL)
+        queue_set_suspend(set, ticks_to_delay);
+    return member;
 }
 
-#endif /* LIBRERTOS_DISABLE_SEMAPHORES */
+#endif /* LIBRERTOS_DISABLE_QUEUE_SETS */
 
-#if (LIBRERTOS_DISABLE_MUTEXES == 0)
+#if (LIBRERTOS_DISABLE_SEMAPHORES == 0)
+
+/**
+ * Initialize the semaphore with an initial value and a maximum value.
+ *
+ * It is recommended to use the functions below instead of this:
+ * - semaphore_init_locked()
+ * - semaphore_init_unlocked()
+ *
+ * @param init_count Initial value of the semaphore.
+ * @param max_count Maximum value of the semaphore.
+ */
+void semaphore_init(semaphore_t *sem, sem_count_t init_count, sem_count_t max_count) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(init_count <= max_count, "Invalid init_count.");
+
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(sem, NONZERO_INITVAL, sizeof(*sem));
+
+    sem->count = init_count;
+    sem->max = max_count;
+    event_init(&sem->event_unlock);
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    sem->set = NULL;
+#endif
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the order in which the semaphore resumes waiting tasks. The default is
+ * EVENT_POLICY.
+ *
+ * Call after initializing the semaphore, before any task waits for it.
+ *
+ * @param policy EVENT_POLICY_PRIORITY or EVENT_POLICY_FIFO.
+ */
+void semaphore_set_policy(semaphore_t *sem, event_policy_t policy) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(priority_bitmap_get_highest(&sem->event_unlock.priorities) < 0,
+        "Cannot change the policy with tasks waiting.");
+
+    CRITICAL_ENTER();
+    event_set_policy(&sem->event_unlock, policy);
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the handoff mode of the semaphore. The default is EVENT_HANDOFF.
+ *
+ * With handoff semaphore_unlock() gives the unit to the task it resumes,
+ * instead of incrementing the count, so no other task can take it first.
+ * The resumed task gets it calling semaphore_lock() or
+ * semaphore_lock_suspend() again.
+ *
+ * @param handoff 1 to enable, 0 to disable.
+ */
+void semaphore_set_handoff(semaphore_t *sem, uint8_t handoff) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    sem->event_unlock.handoff = handoff;
+    CRITICAL_EXIT();
+}
+
+/**
+ * Initialize the semaphore in the locked state (initial value equals zero).
+ *
+ * @param max_count Maximum value of the semaphore.
+ */
+void semaphore_init_locked(semaphore_t *sem, sem_count_t max_count) {
+    semaphore_init(sem, 0, max_count);
+}
+
+/**
+ * Initialize semaphore in the unlocked state (initial value equals maximum
+ * value).
+ *
+ * @param max_count Maximum value of the semaphore.
+ */
+void semaphore_init_unlocked(semaphore_t *sem, sem_count_t max_count) {
+    semaphore_init(sem, max_count, max_count);
+}
+
+/* Call with interrupts disabled. */
+static uint8_t semaphore_can_be_locked(semaphore_t *sem) {
+    return sem->count > 0;
+}
+
+/**
+ * Lock the semaphore.
+ *
+ * @return 1 with success, 0 otherwise.
+ */
+result_t semaphore_lock(semaphore_t *sem) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (event_take_grant(&sem->event_unlock)) {
+        /* Granted by semaphore_unlock() with handoff. */
+        result = LIBRERTOS_SUCCESS;
+    } else if (semaphore_can_be_locked(sem)) {
+        sem->count--;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Lock num units of the semaphore at once, all or none.
+ *
+ * @param num Number of units to lock.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t semaphore_lock_n(semaphore_t *sem, sem_count_t num) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    LIBRERTOS_ASSERT(sem->set == NULL || num <= 1, "Queue set members are locked one unit at a time.");
+#endif
+
+    CRITICAL_ENTER();
+
+    if (event_take_grant(&sem->event_unlock)) {
+        /* Granted by semaphore_unlock_n() with handoff. */
+        result = LIBRERTOS_SUCCESS;
+    } else if (sem->count >= num) {
+        sem->count -= num;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/* Resume the tasks waiting for the semaphore whose units fit in the units
+ * available, in the order of the event, skipping the ones that wait for more.
+ * With handoff the units are granted to them. Return the units granted.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
+static sem_count_t semaphore_resume_tasks(semaphore_t *sem, sem_count_t units) {
+    event_t *event = &sem->event_unlock;
+    sem_count_t granted = 0;
+    int8_t i;
+
+    for (i = priority_bitmap_get_highest(&event->priorities); i >= 0 && units != 0; --i) {
+        struct list_t *list = &event->suspended_tasks[i];
+        struct node_t *node = list_get_first(list);
+
+        while (node != LIST_HEAD(list) && units != 0) {
+            task_t *task = (task_t *)node->owner;
+
+            /* Resuming the task removes the node from the list. */
+            node = node->next;
+
+            if (task->wait_count > units)
+                continue;
+
+            units -= task->wait_count;
+
+            if (event->handoff) {
+                granted += task->wait_count;
+                event_grant_task(task);
+            } else {
+                task_make_ready(task, TASK_WAKE_RESUMED);
+            }
+        }
+    }
+
+    return granted;
+}
+
+/**
+ * Unlock the semaphore.
+ *
+ * @return 1 with success, 0 otherwise.
+ */
+result_t semaphore_unlock(semaphore_t *sem) {
+    return (semaphore_unlock_n(sem, 1) != 0) ? LIBRERTOS_SUCCESS : LIBRERTOS_FAIL;
+}
+
+/**
+ * Unlock up to num units of the semaphore at once, resuming in one pass all
+ * waiting tasks whose units fit in them.
+ *
+ * Takes one critical section for all units, so interrupts releasing several
+ * resources at once should prefer it to calling semaphore_unlock() in a loop.
+ *
+ * @param num Number of units to unlock.
+ * @return Number of units unlocked, limited by the maximum value of the
+ * semaphore.
+ */
+sem_count_t semaphore_unlock_n(semaphore_t *sem, sem_count_t num) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (num > (sem_count_t)(sem->max - sem->count))
+        num = (sem_count_t)(sem->max - sem->count);
+
+    if (num != 0) {
+        sem_count_t granted;
+
+        scheduler_lock();
+
+        granted = semaphore_resume_tasks(sem, (sem_count_t)(sem->count + num));
+        sem->count = (sem_count_t)(sem->count + num - granted);
+
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+        if (sem->set != NULL && num > granted)
+            queue_set_post(sem->set, sem, (queue_size_t)(num - granted));
+#endif
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return num;
+}
+
+/**
+ * Get the current value of the semaphore.
+ */
+sem_count_t semaphore_get_count(semaphore_t *sem) {
+    sem_count_t count;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    count = sem->count;
+    CRITICAL_EXIT();
+    return count;
+}
+
+/**
+ * Get the maximum value of the semaphore.
+ */
+sem_count_t semaphore_get_max(semaphore_t *sem) {
+    /* Semaphore maximum value should not change.
+     * Critical section is not necessary. */
+    return sem->max;
+}
+
+/**
+ * Suspend the task on the semaphore, waiting a maximum number for ticks to pass
+ * before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void semaphore_suspend(semaphore_t *sem, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (!semaphore_can_be_locked(sem)) {
+        scheduler_lock();
+        librertos.current_task->wait_count = 1;
+        event_delay_task(&sem->event_unlock, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Lock the semaphore if unlocked, else tries to suspend the task on the
+ * semaphore, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success locking, 0 otherwise.
+ */
+result_t semaphore_lock_suspend(semaphore_t *sem, tick_t ticks_to_delay) {
+    result_t result = semaphore_lock(sem);
+    if (result == LIBRERTOS_FAIL)
+        semaphore_suspend(sem, ticks_to_delay);
+    return result;
+}
+
+/**
+ * Lock num units of the semaphore if available, else tries to suspend the
+ * task on the semaphore until they are, waiting a maximum number for ticks to
+ * pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param num Number of units to lock.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success locking, 0 otherwise.
+ */
+result_t semaphore_lock_n_suspend(semaphore_t *sem, sem_count_t num, tick_t ticks_to_delay) {
+    result_t result = semaphore_lock_n(sem, num);
+    CRITICAL_VAL();
+
+    if (result == LIBRERTOS_FAIL) {
+        LIBRERTOS_ASSERT(num <= sem->max, "Cannot wait for more than the maximum value.");
+
+        CRITICAL_ENTER();
+
+        if (sem->count < num) {
+            scheduler_lock();
+            librertos.current_task->wait_count = num;
+            event_delay_task(&sem->event_unlock, ticks_to_delay);
+            CRITICAL_EXIT();
+            scheduler_unlock();
+        } else {
+            CRITICAL_EXIT();
+        }
+    }
+
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_SEMAPHORES */
+
+#if (LIBRERTOS_DISABLE_MUTEXES == 0 || LIBRERTOS_DISABLE_RWLOCKS == 0)
+
+/* Call with interrupts disabled. */
+static void task_set_priority(task_t *task, int8_t priority) {
+    struct list_t *ready_list = &librertos.tasks_ready[task->priority];
+    event_t *event = NULL;
+
+    if (node_in_list(&task->event_node) && task->event->policy == EVENT_POLICY_PRIORITY) {
+        event = task->event;
+        task_remove_from_event(task);
+    }
+
+    if (task->sched_node.list == ready_list) {
+        /* Put in the correct ready list. */
+        task_remove_from_sched_list(task);
+        task->priority = priority;
+        list_insert_first(&librertos.tasks_ready[priority], &task->sched_node);
+        priority_bitmap_set(&librertos.priorities_ready, priority);
+    } else {
+        task->priority = priority;
+    }
+
+    if (event != NULL) {
+        /* Put the task in the list of its new priority. Keep it suspended or
+         * delayed.
+         */
+
+        task_t *current_task = librertos.current_task;
+        librertos.current_task = task;
+
+        event_add_task_to_event(event);
+
+        librertos.current_task = current_task;
+    }
+}
+
+/* Get the highest priority of the tasks waiting for the event, -1 if none.
+ * Call with interrupts disabled.
+ */
+static int8_t event_get_highest_priority(event_t *event) {
+    int8_t priority = -1;
+    struct node_t *node;
+
+    if (event->policy == EVENT_POLICY_PRIORITY) {
+        task_t *task = event_get_first_task(event);
+        return (task != NULL) ? task->priority : priority;
+    }
+
+    for (node = list_get_first(&event->suspended_tasks[0]);
+         node != LIST_HEAD(&event->suspended_tasks[0]);
+         node = node->next) {
+        task_t *task = (task_t *)node->owner;
+        if (task->priority > priority)
+            priority = task->priority;
+    }
+
+    return priority;
+}
+
+/* Restore the priority of the task to the highest priority of the tasks
+ * waiting for the mutexes and the reader-writer locks it still holds, or to
+ * its original priority.
+ * Call with interrupts disabled.
+ */
+static void task_restore_priority(task_t *task) {
+    int8_t priority = task->original_priority;
+    int8_t waiting;
+#if (LIBRERTOS_DISABLE_MUTEXES == 0)
+    mutex_t *mtx;
+#endif
+#if (LIBRERTOS_DISABLE_RWLOCKS == 0)
+    rwlock_t *rw;
+#endif
+
+#if (LIBRERTOS_DISABLE_MUTEXES == 0)
+    for (mtx = task->held_mutexes; mtx != NULL; mtx = mtx->next_held) {
+        waiting = event_get_highest_priority(&mtx->event_unlock);
+        if (priority < waiting)
+            priority = waiting;
+    }
+#endif
+
+#if (LIBRERTOS_DISABLE_RWLOCKS == 0)
+    for (rw = task->held_rwlocks; rw != NULL; rw = rw->next_held) {
+        waiting = event_get_highest_priority(&rw->event_read);
+        if (priority < waiting)
+            priority = waiting;
+        waiting = event_get_highest_priority(&rw->event_write);
+        if (priority < waiting)
+            priority = waiting;
+    }
+#endif
+
+    if (task->priority != priority)
+        task_set_priority(task, priority);
+}
+
+#endif /* LIBRERTOS_DISABLE_MUTEXES || LIBRERTOS_DISABLE_RWLOCKS */
+
+#if (LIBRERTOS_DISABLE_MUTEXES == 0)
 
 /**
  * Initialize mutex.
  */
-void mutex_init(mutex_t *mtx) {
+void mutex_init(mutex_t *mtx) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(mtx, NONZERO_INITVAL, sizeof(*mtx));
+
+    mtx->count = 0;
+    mtx->task_owner = NULL;
+    mtx->next_held = NULL;
+    event_init(&mtx->event_unlock);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the order in which the mutex resumes waiting tasks. The default is
+ * EVENT_POLICY. Priority inheritance works with any policy.
+ *
+ * Call after initializing the mutex, before any task waits for it.
+ *
+ * @param policy EVENT_POLICY_PRIORITY or EVENT_POLICY_FIFO.
+ */
+void mutex_set_policy(mutex_t *mtx, event_policy_t policy) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(priority_bitmap_get_highest(&mtx->event_unlock.priorities) < 0,
+        "Cannot change the policy with tasks waiting.");
+
+    CRITICAL_ENTER();
+    event_set_policy(&mtx->event_unlock, policy);
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the handoff mode of the mutex. The default is EVENT_HANDOFF.
+ *
+ * With handoff mutex_unlock() makes the task it resumes the owner, so no
+ * other task can lock it first. The resumed task gets it calling
+ * mutex_lock() or mutex_lock_suspend() again.
+ *
+ * @param handoff 1 to enable, 0 to disable.
+ */
+void mutex_set_handoff(mutex_t *mtx, uint8_t handoff) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    mtx->event_unlock.handoff = handoff;
+    CRITICAL_EXIT();
+}
+
+/* Call with interrupts disabled. */
+static uint8_t mutex_can_be_locked(mutex_t *mtx, task_t *current_task) {
+    return (mtx->count == MUTEX_UNLOCKED ||
+            (current_task == mtx->task_owner && current_task != NULL));
+}
+
+/* Make the task the owner of the mutex and add it to the mutexes the task
+ * holds.
+ * Call with interrupts disabled.
+ */
+static void mutex_set_owner(mutex_t *mtx, task_t *task) {
+    mtx->task_owner = task;
+
+    if (task != NULL) {
+        mtx->next_held = task->held_mutexes;
+        task->held_mutexes = mtx;
+    }
+}
+
+/* Remove the owner of the mutex and remove the mutex from the mutexes the
+ * owner holds.
+ * Call with interrupts disabled.
+ */
+static void mutex_clear_owner(mutex_t *mtx) {
+    task_t *owner = (task_t *)mtx->task_owner;
+    mutex_t **link;
+
+    mtx->task_owner = NULL;
+
+    if (owner == NULL)
+        return;
+
+    for (link = &owner->held_mutexes; *link != NULL; link = &(*link)->next_held) {
+        if (*link == mtx) {
+            *link = mtx->next_held;
+            break;
+        }
+    }
+}
+
+/**
+ * Lock the mutex.
+ *
+ * @return 1 with success, 0 otherwise.
+ */
+result_t mutex_lock(mutex_t *mtx) {
+    result_t result = LIBRERTOS_FAIL;
+    task_t *current_task;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    current_task = librertos.current_task;
+
+    if (event_take_grant(&mtx->event_unlock)) {
+        /* Made the owner by mutex_unlock() with handoff. */
+        result = LIBRERTOS_SUCCESS;
+    } else if (mutex_can_be_locked(mtx, current_task)) {
+        if (mtx->count == MUTEX_UNLOCKED)
+            mutex_set_owner(mtx, current_task);
+        mtx->count++;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/* Raise the priority of the owner of the mutex. If the owner waits for
+ * another mutex, raise the priority of its owner, and so on, crossing at most
+ * MUTEX_INHERITANCE_DEPTH mutexes.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void mutex_inherit_priority(mutex_t *mtx, int8_t priority) {
+    uint8_t depth;
+
+    for (depth = 0; depth < MUTEX_INHERITANCE_DEPTH; depth++) {
+        task_t *owner = (task_t *)mtx->task_owner;
+
+        /* No task or interrupt, or already boosted along the chain. */
+        if (owner == NULL || owner->priority >= priority)
+            break;
+
+        task_set_priority(owner, priority);
+
+        mtx = owner->blocked_mutex;
+        if (mtx == NULL || owner->event != &mtx->event_unlock ||
+            !node_in_list(&owner->event_node))
+            break;
+    }
+}
+
+/* Make the first task waiting for the mutex its owner and resume it. It
+ * inherits the priority of the tasks still waiting.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void mutex_grant_task(mutex_t *mtx, task_t *task) {
+    int8_t priority;
+
+    mtx->count = 1;
+    mutex_set_owner(mtx, task);
+    event_grant_task(task);
+
+    priority = event_get_highest_priority(&mtx->event_unlock);
+    if (task->priority < priority)
+        task_set_priority(task, priority);
+}
+
+/**
+ * Unlock the mutex. The owner falls back to the highest priority of the tasks
+ * waiting for the mutexes it still holds, or to its original priority.
+ */
+void mutex_unlock(mutex_t *mtx) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(mtx->count != MUTEX_UNLOCKED, "Mutex already unlocked.");
+
+    CRITICAL_ENTER();
+
+    if (mtx->count != MUTEX_UNLOCKED) {
+        mtx->count--;
+    }
+
+    if (mtx->count == MUTEX_UNLOCKED) {
+        task_t *owner;
+
+        scheduler_lock();
+
+        owner = (task_t *)mtx->task_owner;
+        mutex_clear_owner(mtx);
+
+        if (owner == NULL) {
+            /* Cannot change priority if no task or interrupt. */
+        } else {
+            task_restore_priority(owner);
+        }
+
+        owner = event_get_first_task(&mtx->event_unlock);
+        if (owner != NULL && mtx->event_unlock.handoff)
+            mutex_grant_task(mtx, owner);
+        else
+            event_resume_task(&mtx->event_unlock);
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Check if the mutex is locked.
+ */
+uint8_t mutex_is_locked(mutex_t *mtx) {
+    uint8_t locked;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    locked = !mutex_can_be_locked(mtx, librertos.current_task);
+    CRITICAL_EXIT();
+    return locked;
+}
+
+/**
+ * Suspend the task on the mutex, waiting a maximum number for ticks to pass
+ * before resuming.
+ *
+ * The owner of the mutex inherits the priority of the task. If the owner
+ * waits for another mutex, its owner inherits it too, up to
+ * MUTEX_INHERITANCE_DEPTH mutexes.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void mutex_suspend(mutex_t *mtx, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (!mutex_can_be_locked(mtx, librertos.current_task)) {
+        scheduler_lock();
+
+        librertos.current_task->blocked_mutex = mtx;
+        mutex_inherit_priority(mtx, librertos.current_task->priority);
+
+        event_delay_task(&mtx->event_unlock, ticks_to_delay);
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Lock the mutex if unlocked, else tries to suspend the task on the
+ * mutex, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success locking, 0 otherwise.
+ */
+result_t mutex_lock_suspend(mutex_t *mtx, tick_t ticks_to_delay) {
+    result_t result = mutex_lock(mtx);
+    if (result == LIBRERTOS_FAIL)
+        mutex_suspend(mtx, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_MUTEXES */
+
+#if (LIBRERTOS_DISABLE_CONDVARS == 0)
+
+/**
+ * Initialize the condition variable, bound to the mutex that protects its
+ * predicate.
+ *
+ * A task locks the mutex and, if the predicate is false, calls
+ * condvar_wait(), which unlocks the mutex, and returns. When signaled with
+ * the mutex unlocked, the mutex is granted to the task, which runs again,
+ * locks the mutex without suspending and checks the predicate again. With
+ * the mutex locked, the task waits for the mutex instead and its owner
+ * inherits the priority of the task. The unlock resumes it as any other task
+ * waiting for the mutex, according to the handoff mode of the mutex (see
+ * mutex_set_handoff()).
+ *
+ * Example:
+ *
+ * ```cpp
+ * void func_task(void *param) {
+ *     if (!mutex_lock_suspend(&mtx, MAX_DELAY))
+ *         return;
+ *
+ *     if (!predicate) {
+ *         condvar_wait(&cv, MAX_DELAY);
+ *         return;
+ *     }
+ *
+ *     // Use the data protected by the mutex
+ *     // ...
+ *
+ *     mutex_unlock(&mtx);
+ * }
+ * ```
+ *
+ * @param mtx Mutex bound to the condition variable.
+ */
+void condvar_init(condvar_t *cv, mutex_t *mtx) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(cv, NONZERO_INITVAL, sizeof(*cv));
+
+    cv->mtx = mtx;
+    event_init(&cv->event_signal);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Suspend the task on the condition variable and unlock the mutex, waiting a
+ * maximum number for ticks to pass before resuming.
+ *
+ * The task must have locked the mutex once. This function can be used only
+ * by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void condvar_wait(condvar_t *cv, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+    LIBRERTOS_ASSERT(cv->mtx->count == 1 && cv->mtx->task_owner == librertos.current_task,
+        "The task must lock the mutex once.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+    event_delay_task(&cv->event_signal, ticks_to_delay);
+    CRITICAL_EXIT();
+
+    /* The scheduler is still locked, no task can run before the mutex is
+     * unlocked. A signal from an interrupt in between moves this task to the
+     * mutex, which the unlock resumes.
+     */
+    mutex_unlock(cv->mtx);
+    scheduler_unlock();
+}
+
+/* Grant the mutex to a task waiting for the condition variable, or move the
+ * task to the mutex, which resumes it when unlocked. The task stays suspended
+ * or delayed until then.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void condvar_wake_task(condvar_t *cv, task_t *task) {
+    mutex_t *mtx = cv->mtx;
+
+    if (mtx->count == MUTEX_UNLOCKED) {
+        mutex_grant_task(mtx, task);
+
+        /* Take the grant in mutex_lock(). */
+        task->event = &mtx->event_unlock;
+    } else {
+        task_t *current_task = librertos.current_task;
+
+        task_remove_from_event(task);
+
+        librertos.current_task = task;
+        event_add_task_to_event(&mtx->event_unlock);
+        librertos.current_task = current_task;
+
+        task->blocked_mutex = mtx;
+        mutex_inherit_priority(mtx, task->priority);
+    }
+}
+
+/**
+ * Wake the first task waiting for the condition variable. Can be used by
+ * tasks, holding the mutex or not, and interrupts.
+ */
+void condvar_signal(condvar_t *cv) {
+    task_t *task;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    task = event_get_first_task(&cv->event_signal);
+    if (task != NULL)
+        condvar_wake_task(cv, task);
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/**
+ * Wake all tasks waiting for the condition variable. They get the mutex one
+ * at a time. Can be used by tasks, holding the mutex or not, and interrupts.
+ */
+void condvar_broadcast(condvar_t *cv) {
+    task_t *task;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    while ((task = event_get_first_task(&cv->event_signal)) != NULL)
+        condvar_wake_task(cv, task);
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+#endif /* LIBRERTOS_DISABLE_CONDVARS */
+
+#if (LIBRERTOS_DISABLE_RWLOCKS == 0)
+
+/**
+ * Initialize the reader-writer lock.
+ *
+ * Many readers or one writer can hold the lock. The writer inherits the
+ * priority of the tasks waiting for the lock. The readers are not tracked,
+ * so a writer waiting for them does not raise their priority.
+ *
+ * When the writer unlocks, all waiting readers are resumed at once. Without
+ * writer preference (the default) a writer is resumed only if no reader is
+ * waiting, and new readers can lock while a writer waits.
+ */
+void rwlock_init(rwlock_t *rw) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(rw, NONZERO_INITVAL, sizeof(*rw));
+
+    rw->readers = 0;
+    rw->write_locked = 0;
+    rw->writer_preference = 0;
+    rw->writer = NULL;
+    rw->next_held = NULL;
+    event_init(&rw->event_read);
+    event_init(&rw->event_write);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the writer preference of the reader-writer lock.
+ *
+ * With writer preference new readers cannot lock while a writer waits, and
+ * the writer unlocking resumes the next writer before the readers.
+ *
+ * @param writer_preference 1 to enable, 0 to disable.
+ */
+void rwlock_set_writer_preference(rwlock_t *rw, uint8_t writer_preference) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    rw->writer_preference = writer_preference;
+    CRITICAL_EXIT();
+}
+
+/* Call with interrupts disabled. */
+static uint8_t rwlock_writers_waiting(rwlock_t *rw) {
+    return priority_bitmap_get_highest(&rw->event_write.priorities) >= 0;
+}
+
+/* Call with interrupts disabled. */
+static uint8_t rwlock_can_be_read_locked(rwlock_t *rw) {
+    return !rw->write_locked && !(rw->writer_preference && rwlock_writers_waiting(rw));
+}
+
+/* Call with interrupts disabled. */
+static uint8_t rwlock_can_be_write_locked(rwlock_t *rw) {
+    return !rw->write_locked && rw->readers == 0;
+}
+
+/* Make the task the writer of the lock and add the lock to the locks the
+ * task holds.
+ * Call with interrupts disabled.
+ */
+static void rwlock_set_writer(rwlock_t *rw, task_t *task) {
+    rw->writer = task;
+
+    if (task != NULL) {
+        rw->next_held = task->held_rwlocks;
+        task->held_rwlocks = rw;
+    }
+}
+
+/* Remove the writer of the lock and remove the lock from the locks the
+ * writer holds.
+ * Call with interrupts disabled.
+ */
+static void rwlock_clear_writer(rwlock_t *rw) {
+    task_t *writer = (task_t *)rw->writer;
+    rwlock_t **link;
+
+    rw->writer = NULL;
+
+    if (writer == NULL)
+        return;
+
+    for (link = &writer->held_rwlocks; *link != NULL; link = &(*link)->next_held) {
+        if (*link == rw) {
+            *link = rw->next_held;
+            break;
+        }
+    }
+}
+
+/**
+ * Lock the reader-writer lock for reading.
+ *
+ * @return 1 with success, 0 otherwise.
+ */
+result_t rwlock_read_lock(rwlock_t *rw) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (rwlock_can_be_read_locked(rw)) {
+        rw->readers++;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Unlock the reader-writer lock locked for reading. The last reader resumes
+ * a waiting writer.
+ */
+void rwlock_read_unlock(rwlock_t *rw) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(rw->readers != 0, "Read lock already unlocked.");
+
+    CRITICAL_ENTER();
+
+    if (--rw->readers == 0) {
+        scheduler_lock();
+        event_resume_task(&rw->event_write);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Lock the reader-writer lock for writing.
+ *
+ * @return 1 with success, 0 otherwise.
+ */
+result_t rwlock_write_lock(rwlock_t *rw) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (rwlock_can_be_write_locked(rw)) {
+        rw->write_locked = 1;
+        rwlock_set_writer(rw, librertos.current_task);
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Unlock the reader-writer lock locked for writing, and resume all waiting
+ * readers or a waiting writer. The writer falls back to the highest priority
+ * of the tasks waiting for the mutexes and locks it still holds, or to its
+ * original priority.
+ */
+void rwlock_write_unlock(rwlock_t *rw) {
+    task_t *writer;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(rw->write_locked, "Write lock already unlocked.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    writer = (task_t *)rw->writer;
+    rwlock_clear_writer(rw);
+    rw->write_locked = 0;
+
+    if (writer != NULL)
+        task_restore_priority(writer);
+
+    if ((rw->writer_preference && rwlock_writers_waiting(rw)) ||
+        priority_bitmap_get_highest(&rw->event_read.priorities) < 0) {
+        event_resume_task(&rw->event_write);
+    } else {
+        event_resume_all(&rw->event_read);
+    }
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/* Suspend the current task on the event, raising the priority of the writer
+ * to the priority of the task.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void rwlock_delay_task(rwlock_t *rw, event_t *event, tick_t ticks_to_delay) {
+    task_t *writer = (task_t *)rw->writer;
+
+    if (rw->write_locked && writer != NULL &&
+        writer->priority < librertos.current_task->priority)
+        task_set_priority(writer, librertos.current_task->priority);
+
+    event_delay_task(event, ticks_to_delay);
+}
+
+/**
+ * Suspend the task on the reader-writer lock until it can lock it for
+ * reading, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void rwlock_read_suspend(rwlock_t *rw, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+
+    if (!rwlock_can_be_read_locked(rw)) {
+        scheduler_lock();
+        rwlock_delay_task(rw, &rw->event_read, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Suspend the task on the reader-writer lock until it can lock it for
+ * writing, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void rwlock_write_suspend(rwlock_t *rw, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+
+    if (!rwlock_can_be_write_locked(rw)) {
+        scheduler_lock();
+        rwlock_delay_task(rw, &rw->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Lock the reader-writer lock for reading if possible, else tries to suspend
+ * the task on it, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success locking, 0 otherwise.
+ */
+result_t rwlock_read_lock_suspend(rwlock_t *rw, tick_t ticks_to_delay) {
+    result_t result = rwlock_read_lock(rw);
+    if (result == LIBRERTOS_FAIL)
+        rwlock_read_suspend(rw, ticks_to_delay);
+    return result;
+}
+
+/**
+ * Lock the reader-writer lock for writing if possible, else tries to suspend
+ * the task on it, waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success locking, 0 otherwise.
+ */
+result_t rwlock_write_lock_suspend(rwlock_t *rw, tick_t ticks_to_delay) {
+    result_t result = rwlock_write_lock(rw);
+    if (result == LIBRERTOS_FAIL)
+        rwlock_write_suspend(rw, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_RWLOCKS */
+
+#if (LIBRERTOS_DISABLE_QUEUES == 0)
+
+/**
+ * Initialize the queue.
+ *
+ * @param buff Pointer to a buffer with size que_size*item_size.
+ * @param que_size Number of items the queue can hold.
+ * @param item_size Size of the items in the queue.
+ */
+void queue_init(queue_t *que, void *buff, queue_size_t que_size, item_size_t item_size) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(que, NONZERO_INITVAL, sizeof(*que));
+
+    que->free = que_size;
+    que->used = 0;
+    que->head = 0;
+    que->tail = 0;
+    que->item_size = item_size;
+    que->end = (size_t)que_size * item_size;
+    que->buff = (uint8_t *)buff;
+    event_init(&que->event_write);
+    event_init(&que->event_read);
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    que->set = NULL;
+#endif
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the order in which the queue resumes waiting tasks. The default is
+ * EVENT_POLICY.
+ *
+ * Call after initializing the queue, before any task waits for it.
+ *
+ * @param policy EVENT_POLICY_PRIORITY or EVENT_POLICY_FIFO.
+ */
+void queue_set_policy(queue_t *que, event_policy_t policy) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(priority_bitmap_get_highest(&que->event_write.priorities) < 0
+            && priority_bitmap_get_highest(&que->event_read.priorities) < 0,
+        "Cannot change the policy with tasks waiting.");
+
+    CRITICAL_ENTER();
+    event_set_policy(&que->event_write, policy);
+    event_set_policy(&que->event_read, policy);
+    CRITICAL_EXIT();
+}
+
+/**
+ * Set the handoff mode of the queue. The default is EVENT_HANDOFF.
+ *
+ * With handoff queue_write() on an empty queue copies the item directly to
+ * the buffer of the task waiting in queue_read_suspend() that it resumes,
+ * so no other task can read it first. The resumed task gets it calling
+ * queue_read_suspend() again with the same buffer, which must remain valid
+ * while the task waits.
+ *
+ * @param handoff 1 to enable, 0 to disable.
+ */
+void queue_set_handoff(queue_t *que, uint8_t handoff) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    que->event_write.handoff = handoff;
+    CRITICAL_EXIT();
+}
+
+/* Call with interrupts disabled. */
+static uint8_t queue_can_be_read(queue_t *que) {
+    return que->used > 0;
+}
+
+/* Call with interrupts disabled. */
+static uint8_t queue_can_be_written(queue_t *que) {
+    return que->free > 0;
+}
+
+/* Remove the item at the tail and resume a task waiting to write.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void queue_release_tail(queue_t *que) {
+    que->tail += que->item_size;
+    if (que->tail >= que->end)
+        que->tail = 0;
+
+    que->free++;
+    que->used--;
+
+    event_resume_task(&que->event_read);
+}
+
+/* Add the item at the head and resume a waiting task.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void queue_commit_head(queue_t *que) {
+    que->head += que->item_size;
+    if (que->head >= que->end)
+        que->head = 0;
+
+    que->free--;
+    que->used++;
+
+    event_resume_task(&que->event_write);
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    if (que->set != NULL)
+        queue_set_post(que->set, que, 1);
+#endif
+}
+
+/* With handoff, copy the item directly to the first task waiting to read the
+ * empty queue and grant it. Return 1 if the item was handed off.
+ *
+ * Call with interrupts disabled and scheduler locked.
+ */
+static result_t queue_handoff_item(queue_t *que, const void *data) {
+    task_t *task = event_get_first_task(&que->event_write);
+
+    if (task == NULL || task->handoff_data == NULL ||
+        !que->event_write.handoff || que->used != 0)
+        return LIBRERTOS_FAIL;
+
+    memcpy(task->handoff_data, data, que->item_size);
+    event_grant_task(task);
+    return LIBRERTOS_SUCCESS;
+}
+
+/**
+ * Read an item from the queue.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t queue_read(queue_t *que, void *data) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (queue_can_be_read(que)) {
+        scheduler_lock();
+
+        memcpy(data, &que->buff[que->tail], que->item_size);
+        queue_release_tail(que);
+        result = LIBRERTOS_SUCCESS;
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return result;
+}
+
+/**
+ * Write an item to the queue.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t queue_write(queue_t *que, const void *data) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (queue_can_be_written(que)) {
+        scheduler_lock();
+
+        if (!queue_handoff_item(que, data)) {
+            memcpy(&que->buff[que->head], data, que->item_size);
+            queue_commit_head(que);
+        }
+
+        result = LIBRERTOS_SUCCESS;
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return result;
+}
+
+/**
+ * Write an item to the front of the queue, to be read before the items
+ * already in the queue.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t queue_write_front(queue_t *que, const void *data) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (queue_can_be_written(que)) {
+        scheduler_lock();
+
+        if (!queue_handoff_item(que, data)) {
+            if (que->tail == 0)
+                que->tail = que->end;
+            que->tail -= que->item_size;
+
+            memcpy(&que->buff[que->tail], data, que->item_size);
+
+            que->free--;
+            que->used++;
+
+            event_resume_task(&que->event_write);
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+            if (que->set != NULL)
+                queue_set_post(que->set, que, 1);
+#endif
+        }
+
+        result = LIBRERTOS_SUCCESS;
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return result;
+}
+
+/**
+ * Get a pointer to the next item to be read, to read it in place without
+ * copying. Call queue_read_release() after reading it.
+ *
+ * Only one task or interrupt can read the queue between queue_read_peek()
+ * and queue_read_release().
+ *
+ * @return Pointer to the item, NULL if the queue is empty.
+ */
+void *queue_read_peek(queue_t *que) {
+    void *item = NULL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (queue_can_be_read(que))
+        item = &que->buff[que->tail];
+
+    CRITICAL_EXIT();
+    return item;
+}
+
+/**
+ * Remove the item returned by queue_read_peek() from the queue and resume a
+ * task waiting to write.
+ */
+void queue_read_release(queue_t *que) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(que->used > 0, "No item to release.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+    queue_release_tail(que);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/**
+ * Get a pointer to the next free item, to write it in place without copying.
+ * Call queue_write_commit() after writing it, which makes the item available
+ * to the readers.
+ *
+ * Only one task or interrupt can write the queue between
+ * queue_write_reserve() and queue_write_commit().
+ *
+ * @return Pointer to the item, NULL if the queue is full.
+ */
+void *queue_write_reserve(queue_t *que) {
+    void *item = NULL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (queue_can_be_written(que))
+        item = &que->buff[que->head];
+
+    CRITICAL_EXIT();
+    return item;
+}
+
+/**
+ * Add the item returned by queue_write_reserve() to the queue and resume a
+ * task waiting to read it. With handoff the item is copied to the task
+ * instead, and the reserved slot stays free.
+ */
+void queue_write_commit(queue_t *que) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(que->free > 0, "No item to commit.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+    if (!queue_handoff_item(que, &que->buff[que->head]))
+        queue_commit_head(que);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/**
+ * Read up to num_items items from the queue.
+ *
+ * The items are copied with at most two memcpy(), one before and one after
+ * the end of the buffer. One waiting task is resumed for each item read, so
+ * that all writers blocked on a full queue can write an item.
+ *
+ * @param data Pointer to a buffer with size num_items*que->item_size.
+ * @param num_items Maximum number of items to read.
+ * @return Number of items read.
+ */
+queue_size_t queue_read_n(queue_t *que, void *data, queue_size_t num_items) {
+    queue_size_t num;
+    CRITICAL_VAL();
+
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+    LIBRERTOS_ASSERT(que->set == NULL || num_items <= 1, "Queue set members are read one item at a time.");
+#endif
+
+    CRITICAL_ENTER();
+
+    num = (num_items < que->used) ? num_items : que->used;
+
+    if (num != 0) {
+        size_t size = (size_t)num * que->item_size;
+        size_t first = que->end - que->tail;
+        queue_size_t writers;
+
+        if (first > size)
+            first = size;
+
+        scheduler_lock();
+
+        memcpy(data, &que->buff[que->tail], first);
+        if (size != first)
+            memcpy((uint8_t *)data + first, &que->buff[0], size - first);
+
+        que->tail += size;
+        if (que->tail >= que->end)
+            que->tail -= que->end;
+
+        que->free += num;
+        que->used -= num;
+
+        for (writers = 0; writers < num; ++writers) {
+            if (!event_resume_task(&que->event_read))
+                break;
+        }
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return num;
+}
+
+/**
+ * Write up to num_items items to the queue.
+ *
+ * With handoff, the first items go directly to the tasks waiting to read the
+ * empty queue, one each. The other items are copied with at most two memcpy(),
+ * one before and one after the end of the buffer. One waiting task is resumed
+ * for each item written, so that all readers blocked on an empty queue can get
+ * an item.
+ *
+ * @param data Pointer to a buffer with size num_items*que->item_size.
+ * @param num_items Maximum number of items to write.
+ * @return Number of items written.
+ */
+queue_size_t queue_write_n(queue_t *que, const void *data, queue_size_t num_items) {
+    queue_size_t handed_off = 0;
+    queue_size_t num;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    if (que->free != 0) {
+        while (handed_off < num_items && queue_handoff_item(que, data)) {
+            data = (const uint8_t *)data + que->item_size;
+            handed_off++;
+        }
+    }
+
+    num = num_items - handed_off;
+    if (num > que->free)
+        num = que->free;
+
+    if (num != 0) {
+        size_t size = (size_t)num * que->item_size;
+        size_t first = que->end - que->head;
+        queue_size_t readers;
+
+        if (first > size)
+            first = size;
+
+        memcpy(&que->buff[que->head], data, first);
+        if (size != first)
+            memcpy(&que->buff[0], (const uint8_t *)data + first, size - first);
+
+        que->head += size;
+        if (que->head >= que->end)
+            que->head -= que->end;
+
+        que->free -= num;
+        que->used += num;
+
+        for (readers = 0; readers < num; ++readers) {
+            if (!event_resume_task(&que->event_write))
+                break;
+        }
+#if (LIBRERTOS_DISABLE_QUEUE_SETS == 0)
+        if (que->set != NULL)
+            queue_set_post(que->set, que, num);
+#endif
+    }
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+
+    return handed_off + num;
+}
+
+/**
+ * Get number of free items in the queue.
+ */
+queue_size_t queue_get_num_free(queue_t *que) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = que->free;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Get number of used items in the queue.
+ */
+queue_size_t queue_get_num_used(queue_t *que) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = que->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Check if the queue is empty (zero items used).
+ */
+uint8_t queue_is_empty(queue_t *que) {
+    return queue_get_num_used(que) == 0;
+}
+
+/**
+ * Check if the queue is full (all items used).
+ */
+uint8_t queue_is_full(queue_t *que) {
+    return queue_get_num_free(que) == 0;
+}
+
+/**
+ * Get total number of items in the queue (free + used).
+ */
+queue_size_t queue_get_num_items(queue_t *que) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = que->free + que->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Get the size of the items in the queue.
+ */
+item_size_t queue_get_item_size(queue_t *que) {
+    /* Queue item size should not change.
+     * Critical section is not necessary. */
+    return que->item_size;
+}
+
+/**
+ * Suspend the task waiting to read the queue, waiting a maximum number for
+ * ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void queue_suspend(queue_t *que, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (!queue_can_be_read(que)) {
+        scheduler_lock();
+        librertos.current_task->handoff_data = NULL;
+        event_delay_task(&que->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read an item from the the queue if not empty, else tries to suspend the task
+ * waiting to read the queue, waiting a maximum number for ticks to pass before
+ * resuming.
+ *
+ * With handoff (see queue_set_handoff()) a writer can copy the item directly
+ * to data while the task waits. Call again with the same buffer when resumed.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t queue_read_suspend(queue_t *que, void *data, tick_t ticks_to_delay) {
+    result_t result = LIBRERTOS_SUCCESS;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    if (event_take_grant(&que->event_write)) {
+        /* The item was handed off to data. */
+    } else if (queue_can_be_read(que)) {
+        memcpy(data, &que->buff[que->tail], que->item_size);
+        queue_release_tail(que);
+    } else {
+        librertos.current_task->handoff_data = data;
+        event_delay_task(&que->event_write, ticks_to_delay);
+        result = LIBRERTOS_FAIL;
+    }
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+    return result;
+}
+
+/**
+ * Suspend the task waiting to write the queue, waiting a maximum number for
+ * ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void queue_write_wait(queue_t *que, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (!queue_can_be_written(que)) {
+        scheduler_lock();
+        event_delay_task(&que->event_read, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Write an item to the queue if not full, else tries to suspend the task
+ * waiting to write the queue, waiting a maximum number for ticks to pass
+ * before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success writing, 0 otherwise.
+ */
+result_t queue_write_suspend(queue_t *que, const void *data, tick_t ticks_to_delay) {
+    result_t result = queue_write(que, data);
+    if (result == LIBRERTOS_FAIL)
+        queue_write_wait(que, ticks_to_delay);
+    return result;
+}
+
+/**
+ * Initialize the priority queue.
+ *
+ * Items are read highest priority first and in FIFO order within the same
+ * priority. The slots of the buffer are shared by all priorities and linked
+ * in one list per priority, so reading and writing take time bounded by
+ * PRIO_QUEUE_LEVELS, not by the number of items.
+ *
+ * @param buff Pointer to a buffer with size que_size*item_size.
+ * @param links Pointer to an array of que_size queue_size_t, to link the
+ * slots.
+ * @param que_size Number of items the queue can hold.
+ * @param item_size Size of the items in the queue.
+ */
+void prio_queue_init(prio_queue_t *que, void *buff, queue_size_t *links, queue_size_t que_size, item_size_t item_size) {
+    queue_size_t i;
+    uint8_t level;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(que, NONZERO_INITVAL, sizeof(*que));
+
+    /* The index que_size marks the end of a list. */
+    for (i = 0; i < que_size; ++i)
+        links[i] = (queue_size_t)(i + 1);
+
+    for (level = 0; level < PRIO_QUEUE_LEVELS; ++level) {
+        que->first[level] = que_size;
+        que->last[level] = que_size;
+    }
+
+    que->free_slot = 0;
+    que->size = que_size;
+    que->used = 0;
+    que->item_size = item_size;
+    que->links = links;
+    que->buff = (uint8_t *)buff;
+    event_init(&que->event_write);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Read the highest priority item from the queue.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param priority Pointer to receive the priority of the item, or NULL.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t prio_queue_read(prio_queue_t *que, void *data, uint8_t *priority) {
+    result_t result = LIBRERTOS_FAIL;
+    uint8_t level = PRIO_QUEUE_LEVELS;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (que->used > 0) {
+        queue_size_t slot;
+
+        do {
+            --level;
+        } while (que->first[level] == que->size);
+
+        slot = que->first[level];
+        que->first[level] = que->links[slot];
+
+        memcpy(data, &que->buff[(size_t)slot * que->item_size], que->item_size);
+
+        que->links[slot] = que->free_slot;
+        que->free_slot = slot;
+        que->used--;
+
+        if (priority != NULL)
+            *priority = level;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Write an item to the queue, after the items with the same or higher
+ * priority.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param priority Priority of the item, from 0 to PRIO_QUEUE_LEVELS-1.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t prio_queue_write(prio_queue_t *que, const void *data, uint8_t priority) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(priority < PRIO_QUEUE_LEVELS, "Invalid item priority.");
+
+    CRITICAL_ENTER();
+
+    if (que->used < que->size) {
+        queue_size_t slot = que->free_slot;
+
+        scheduler_lock();
+
+        que->free_slot = que->links[slot];
+
+        memcpy(&que->buff[(size_t)slot * que->item_size], data, que->item_size);
+
+        que->links[slot] = que->size;
+        if (que->first[priority] == que->size)
+            que->first[priority] = slot;
+        else
+            que->links[que->last[priority]] = slot;
+        que->last[priority] = slot;
+        que->used++;
+
+        event_resume_task(&que->event_write);
+        result = LIBRERTOS_SUCCESS;
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return result;
+}
+
+/**
+ * Get number of used items in the priority queue.
+ */
+queue_size_t prio_queue_get_num_used(prio_queue_t *que) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = que->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Get number of free items in the priority queue.
+ */
+queue_size_t prio_queue_get_num_free(prio_queue_t *que) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = que->size - que->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Suspend the task waiting to read the priority queue, waiting a maximum
+ * number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void prio_queue_suspend(prio_queue_t *que, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (que->used == 0) {
+        scheduler_lock();
+        event_delay_task(&que->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read the highest priority item from the queue if not empty, else tries to
+ * suspend the task waiting to read the queue, waiting a maximum number for
+ * ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param priority Pointer to receive the priority of the item, or NULL.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t prio_queue_read_suspend(prio_queue_t *que, void *data, uint8_t *priority, tick_t ticks_to_delay) {
+    result_t result = prio_queue_read(que, data, priority);
+    if (result == LIBRERTOS_FAIL)
+        prio_queue_suspend(que, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_QUEUES */
+
+#if (LIBRERTOS_DISABLE_SPSC_QUEUES == 0)
+
+/**
+ * Initialize the single-producer single-consumer queue.
+ *
+ * The queue does not use critical sections to read or write, only memory
+ * barriers. It can be used by one producer (task or interrupt) and one
+ * consumer (task or interrupt) at the same time. The CPU must read and write
+ * queue_size_t atomically.
+ *
+ * @param buff Pointer to a buffer with size que_size*item_size.
+ * @param que_size Number of items the queue can hold, a power of two.
+ * @param item_size Size of the items in the queue.
+ */
+void spsc_queue_init(spsc_queue_t *que, void *buff, queue_size_t que_size, item_size_t item_size) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(que_size != 0 && (que_size & (que_size - 1)) == 0,
+        "Queue size must be a power of two.");
+
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(que, NONZERO_INITVAL, sizeof(*que));
+
+    que->head = 0;
+    que->tail = 0;
+    que->mask = (queue_size_t)(que_size - 1);
+    que->item_size = item_size;
+    que->consumer_suspended = 0;
+    que->buff = (uint8_t *)buff;
+    event_init(&que->event_write);
+
+    CRITICAL_EXIT();
+}
+
+/* Resume the consumer if it is suspended. */
+static void spsc_queue_resume_consumer(spsc_queue_t *que) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (que->consumer_suspended) {
+        que->consumer_suspended = 0;
+
+        scheduler_lock();
+        event_resume_task(&que->event_write);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read an item from the queue. Only the consumer can call this function.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t spsc_queue_read(spsc_queue_t *que, void *data) {
+    queue_size_t tail = que->tail;
+
+    if (que->head == tail)
+        return LIBRERTOS_FAIL;
+
+    /* Read the head before the item. */
+    PORT_ACQUIRE_BARRIER();
+
+    memcpy(data, &que->buff[(size_t)(tail & que->mask) * que->item_size], que->item_size);
+
+    /* Read the item before releasing it to the producer. */
+    PORT_RELEASE_BARRIER();
+
+    que->tail = (queue_size_t)(tail + 1);
+
+    return LIBRERTOS_SUCCESS;
+}
+
+/**
+ * Write an item to the queue. Only the producer can call this function.
+ *
+ * Enters a critical section only if the consumer is suspended on the queue.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t spsc_queue_write(spsc_queue_t *que, const void *data) {
+    queue_size_t head = que->head;
+
+    if ((queue_size_t)(head - que->tail) > que->mask)
+        return LIBRERTOS_FAIL;
+
+    /* Read the tail before overwriting the item it released. */
+    PORT_ACQUIRE_BARRIER();
+
+    memcpy(&que->buff[(size_t)(head & que->mask) * que->item_size], data, que->item_size);
+
+    /* Write the item before publishing it to the consumer. */
+    PORT_RELEASE_BARRIER();
+
+    que->head = (queue_size_t)(head + 1);
+
+    /* Publish the head before checking the consumer, which sets the flag
+     * before checking the head.
+     */
+    PORT_MEMORY_BARRIER();
+
+    if (que->consumer_suspended)
+        spsc_queue_resume_consumer(que);
+
+    return LIBRERTOS_SUCCESS;
+}
+
+/**
+ * Get number of used items in the queue.
+ */
+queue_size_t spsc_queue_get_num_used(spsc_queue_t *que) {
+    queue_size_t tail = que->tail;
+    return (queue_size_t)(que->head - tail);
+}
+
+/**
+ * Suspend the consumer task waiting to read the queue, waiting a maximum
+ * number for ticks to pass before resuming.
+ *
+ * This function can be used only by the consumer task.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void spsc_queue_suspend(spsc_queue_t *que, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    que->consumer_suspended = 1;
+
+    /* Set the flag before checking the head, which the producer publishes
+     * before checking the flag.
+     */
+    PORT_MEMORY_BARRIER();
+
+    if (que->head == que->tail) {
+        scheduler_lock();
+        event_delay_task(&que->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        que->consumer_suspended = 0;
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read an item from the the queue if not empty, else tries to suspend the task
+ * waiting to read the queue, waiting a maximum number for ticks to pass before
+ * resuming.
+ *
+ * This function can be used only by the consumer task.
+ *
+ * @param data Pointer to a buffer with size que->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t spsc_queue_read_suspend(spsc_queue_t *que, void *data, tick_t ticks_to_delay) {
+    result_t result = spsc_queue_read(que, data);
+    if (result == LIBRERTOS_FAIL)
+        spsc_queue_suspend(que, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_SPSC_QUEUES */
+
+#if (LIBRERTOS_DISABLE_MAILBOXES == 0)
+
+/**
+ * Initialize the mailbox.
+ *
+ * The mailbox holds only the latest value written. Its version counts the
+ * values written, skipping zero, which means that no value was written yet.
+ * Each reader keeps the version of the last value it read, starting with
+ * zero, to read only newer values.
+ *
+ * @param buff Pointer to a buffer with size item_size.
+ * @param item_size Size of the value in the mailbox.
+ */
+void mailbox_init(mailbox_t *mbx, void *buff, item_size_t item_size) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(mbx, NONZERO_INITVAL, sizeof(*mbx));
+
+    mbx->version = 0;
+    mbx->item_size = item_size;
+    mbx->buff = (uint8_t *)buff;
+    event_init(&mbx->event_write);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Overwrite the value in the mailbox and resume all tasks waiting for a new
+ * value. Never fails and never blocks.
+ *
+ * @param data Pointer to a buffer with size mbx->item_size.
+ */
+void mailbox_overwrite(mailbox_t *mbx, const void *data) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    memcpy(mbx->buff, data, mbx->item_size);
+
+    if (++mbx->version == 0)
+        mbx->version = 1;
+
+    event_resume_all(&mbx->event_write);
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/**
+ * Read the value from the mailbox if it is newer than the version of the
+ * last value read. Nothing is copied otherwise.
+ *
+ * @param data Pointer to a buffer with size mbx->item_size.
+ * @param version Pointer to the version of the last value read, updated
+ * with the version of the value read.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t mailbox_read(mailbox_t *mbx, void *data, mailbox_version_t *version) {
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (mbx->version != *version) {
+        memcpy(data, mbx->buff, mbx->item_size);
+        *version = mbx->version;
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Get the version of the value in the mailbox, zero if no value was written.
+ */
+mailbox_version_t mailbox_get_version(mailbox_t *mbx) {
+    mailbox_version_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = mbx->version;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Suspend the task waiting for a value newer than version, waiting a maximum
+ * number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param version Version of the last value read.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void mailbox_suspend(mailbox_t *mbx, mailbox_version_t version, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (mbx->version == version) {
+        scheduler_lock();
+        event_delay_task(&mbx->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read the value from the mailbox if it is newer than the version of the
+ * last value read, else tries to suspend the task waiting for a new value,
+ * waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size mbx->item_size.
+ * @param version Pointer to the version of the last value read, updated
+ * with the version of the value read.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t mailbox_read_suspend(mailbox_t *mbx, void *data, mailbox_version_t *version, tick_t ticks_to_delay) {
+    result_t result = mailbox_read(mbx, data, version);
+    if (result == LIBRERTOS_FAIL)
+        mailbox_suspend(mbx, *version, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_MAILBOXES */
+
+#if (LIBRERTOS_DISABLE_STREAM_BUFFERS == 0)
+
+/**
+ * Initialize the stream buffer.
+ *
+ * A stream buffer holds bytes instead of fixed-size items. A reader suspended
+ * on it is resumed when at least trigger bytes are available.
+ *
+ * @param buff Pointer to a buffer with size buff_size.
+ * @param buff_size Number of bytes the stream buffer can hold.
+ * @param trigger Number of bytes to resume a reader, from 1 to buff_size.
+ */
+void stream_buffer_init(stream_buffer_t *stm, void *buff, queue_size_t buff_size, queue_size_t trigger) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(trigger > 0 && trigger <= buff_size, "Invalid trigger level.");
+
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(stm, NONZERO_INITVAL, sizeof(*stm));
+
+    stm->head = 0;
+    stm->tail = 0;
+    stm->used = 0;
+    stm->size = buff_size;
+    stm->trigger = trigger;
+    stm->buff = (uint8_t *)buff;
+    event_init(&stm->event_write);
+
+    CRITICAL_EXIT();
+}
+
+/* Copy bytes to the head, with at most two memcpy().
+ * Call with interrupts disabled.
+ */
+static void stream_buffer_copy_in(stream_buffer_t *stm, const uint8_t *data, queue_size_t size) {
+    queue_size_t first = stm->size - stm->head;
+
+    if (first > size)
+        first = size;
+
+    memcpy(&stm->buff[stm->head], data, first);
+
+    if (size != first) {
+        memcpy(&stm->buff[0], data + first, size - first);
+        stm->head = size - first;
+    } else {
+        stm->head += size;
+        if (stm->head == stm->size)
+            stm->head = 0;
+    }
+
+    stm->used += size;
+}
+
+/* Copy bytes from the tail without removing them, with at most two memcpy().
+ * Call with interrupts disabled.
+ */
+static void stream_buffer_copy_out(stream_buffer_t *stm, uint8_t *data, queue_size_t size) {
+    queue_size_t first = stm->size - stm->tail;
+
+    if (first > size)
+        first = size;
+
+    memcpy(data, &stm->buff[stm->tail], first);
+    if (size != first)
+        memcpy(data + first, &stm->buff[0], size - first);
+}
+
+/* Remove bytes from the tail. Call with interrupts disabled. */
+static void stream_buffer_release(stream_buffer_t *stm, queue_size_t size) {
+    queue_size_t first = stm->size - stm->tail;
+
+    if (size < first) {
+        stm->tail += size;
+    } else {
+        stm->tail = size - first;
+    }
+
+    stm->used -= size;
+}
+
+/* Resume a reader if the trigger level was reached.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static void stream_buffer_resume_reader(stream_buffer_t *stm) {
+    if (stm->used >= stm->trigger)
+        event_resume_task(&stm->event_write);
+}
+
+/**
+ * Read up to size bytes from the stream buffer.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Maximum number of bytes to read.
+ * @return Number of bytes read.
+ */
+queue_size_t stream_buffer_read(stream_buffer_t *stm, void *data, queue_size_t size) {
+    queue_size_t num;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    num = (size < stm->used) ? size : stm->used;
+
+    if (num != 0) {
+        stream_buffer_copy_out(stm, (uint8_t *)data, num);
+        stream_buffer_release(stm, num);
+    }
+
+    CRITICAL_EXIT();
+    return num;
+}
+
+/**
+ * Write up to size bytes to the stream buffer, with one critical section for
+ * all of them. A reader is resumed if the trigger level is reached.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Maximum number of bytes to write.
+ * @return Number of bytes written.
+ */
+queue_size_t stream_buffer_write(stream_buffer_t *stm, const void *data, queue_size_t size) {
+    queue_size_t num;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    num = stm->size - stm->used;
+    if (num > size)
+        num = size;
+
+    if (num != 0) {
+        scheduler_lock();
+
+        stream_buffer_copy_in(stm, (const uint8_t *)data, num);
+        stream_buffer_resume_reader(stm);
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return num;
+}
+
+/**
+ * Get number of bytes in the stream buffer.
+ */
+queue_size_t stream_buffer_get_num_used(stream_buffer_t *stm) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = stm->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Get number of free bytes in the stream buffer.
+ */
+queue_size_t stream_buffer_get_num_free(stream_buffer_t *stm) {
+    queue_size_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = stm->size - stm->used;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Suspend the task waiting for the trigger level of bytes, waiting a maximum
+ * number for ticks to pass before resuming.
+ *
+ * After the timeout the task can read the bytes available with
+ * stream_buffer_read().
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void stream_buffer_suspend(stream_buffer_t *stm, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (stm->used < stm->trigger) {
+        scheduler_lock();
+        event_delay_task(&stm->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read up to size bytes from the stream buffer if at least the trigger level
+ * of bytes is available, else tries to suspend the task waiting for them,
+ * waiting a maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Maximum number of bytes to read.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return Number of bytes read.
+ */
+queue_size_t stream_buffer_read_suspend(stream_buffer_t *stm, void *data, queue_size_t size, tick_t ticks_to_delay) {
+    queue_size_t num = 0;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (stm->used >= stm->trigger) {
+        num = (size < stm->used) ? size : stm->used;
+        stream_buffer_copy_out(stm, (uint8_t *)data, num);
+        stream_buffer_release(stm, num);
+        CRITICAL_EXIT();
+    } else {
+        scheduler_lock();
+        event_delay_task(&stm->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    }
+
+    return num;
+}
+
+/**
+ * Initialize the message buffer.
+ *
+ * A message buffer is a stream buffer that holds variable-size messages,
+ * each one prefixed by its length. Messages are written and read whole, with
+ * one copy each way.
+ *
+ * @param buff Pointer to a buffer with size buff_size.
+ * @param buff_size Number of bytes the message buffer can hold, including
+ * sizeof(item_size_t) bytes per message for its length.
+ */
+void message_buffer_init(message_buffer_t *msg, void *buff, queue_size_t buff_size) {
+    stream_buffer_init(&msg->stream, buff, buff_size, 1);
+}
+
+/**
+ * Read a message from the message buffer.
+ *
+ * The message is left in the message buffer if it does not fit the buffer.
+ * Then message_buffer_get_next_length() reports the size it needs, while it
+ * reports 0 if there is no message.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Size of the buffer.
+ * @return Length of the message read, 0 if there is no message or it does
+ * not fit the buffer.
+ */
+item_size_t message_buffer_read(message_buffer_t *msg, void *data, item_size_t size) {
+    stream_buffer_t *stm = &msg->stream;
+    item_size_t length = 0;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (stm->used > 0) {
+        stream_buffer_copy_out(stm, (uint8_t *)&length, sizeof(length));
+
+        if (length <= size) {
+            stream_buffer_release(stm, sizeof(length));
+            stream_buffer_copy_out(stm, (uint8_t *)data, length);
+            stream_buffer_release(stm, length);
+        } else {
+            /* Keep it, message_buffer_get_next_length() reports its size. */
+            length = 0;
+        }
+    }
+
+    CRITICAL_EXIT();
+    return length;
+}
+
+/**
+ * Write a message to the message buffer, if there is space for all of it.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Length of the message, greater than zero.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t message_buffer_write(message_buffer_t *msg, const void *data, item_size_t size) {
+    stream_buffer_t *stm = &msg->stream;
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(size > 0, "Message cannot be empty.");
+
+    CRITICAL_ENTER();
+
+    if ((size_t)stm->size - stm->used >= sizeof(size) + (size_t)size) {
+        scheduler_lock();
+
+        stream_buffer_copy_in(stm, (const uint8_t *)&size, sizeof(size));
+        stream_buffer_copy_in(stm, (const uint8_t *)data, size);
+        stream_buffer_resume_reader(stm);
+        result = LIBRERTOS_SUCCESS;
+
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+
+    return result;
+}
+
+/**
+ * Check if the message buffer is empty (no messages).
+ */
+uint8_t message_buffer_is_empty(message_buffer_t *msg) {
+    return stream_buffer_get_num_used(&msg->stream) == 0;
+}
+
+/**
+ * Get the length of the next message, the size of the buffer needed to read
+ * it.
+ *
+ * @return Length of the next message, 0 if there is no message.
+ */
+item_size_t message_buffer_get_next_length(message_buffer_t *msg) {
+    stream_buffer_t *stm = &msg->stream;
+    item_size_t length = 0;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (stm->used > 0)
+        stream_buffer_copy_out(stm, (uint8_t *)&length, sizeof(length));
+
+    CRITICAL_EXIT();
+    return length;
+}
+
+/**
+ * Suspend the task waiting for a message, waiting a maximum number for ticks
+ * to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void message_buffer_suspend(message_buffer_t *msg, tick_t ticks_to_delay) {
+    stream_buffer_suspend(&msg->stream, ticks_to_delay);
+}
+
+/**
+ * Read a message from the message buffer if not empty, else tries to suspend
+ * the task waiting for a message, waiting a maximum number for ticks to pass
+ * before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size bytes.
+ * @param size Size of the buffer.
+ * The task does not suspend if there is a message that does not fit the
+ * buffer, check message_buffer_get_next_length().
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return Length of the message read, 0 otherwise.
+ */
+item_size_t message_buffer_read_suspend(message_buffer_t *msg, void *data, item_size_t size, tick_t ticks_to_delay) {
+    item_size_t length = message_buffer_read(msg, data, size);
+    if (length == 0)
+        message_buffer_suspend(msg, ticks_to_delay);
+    return length;
+}
+
+#endif /* LIBRERTOS_DISABLE_STREAM_BUFFERS */
+
+#if (LIBRERTOS_DISABLE_TOPICS == 0)
+
+/**
+ * Initialize the topic.
+ *
+ * A publisher writes each item once to a ring of slots shared by all
+ * subscribers. Each subscriber has its own read cursor, the sequence number
+ * of the next item to read, and its own event to wait for items. Publishing
+ * never blocks: a subscriber that falls more than que_size items behind
+ * skips the items that were overwritten.
+ *
+ * @param buff Pointer to a buffer with size que_size*item_size.
+ * @param que_size Number of items the topic keeps.
+ * @param item_size Size of the items in the topic.
+ */
+void topic_init(topic_t *top, void *buff, queue_size_t que_size, item_size_t item_size) {
     CRITICAL_VAL();
     CRITICAL_ENTER();
 
     /* Make non-zero, to be easy to spot uninitialized fields. */
-    memset(mtx, NONZERO_INITVAL, sizeof(*mtx));
+    memset(top, NONZERO_INITVAL, sizeof(*top));
 
-    mtx->count = 0;
-    mtx->task_owner = NULL;
-    event_init(&mtx->event_unlock);
+    top->sequence = 0;
+    top->head = 0;
+    top->size = que_size;
+    top->item_size = item_size;
+    top->buff = (uint8_t *)buff;
+    list_init(&top->subscribers);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Subscribe to the topic. The subscriber reads only the items published
+ * after subscribing.
+ */
+void topic_subscribe(topic_t *top, subscriber_t *sub) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(sub, NONZERO_INITVAL, sizeof(*sub));
+
+    sub->topic = top;
+    sub->cursor = top->sequence;
+    sub->skipped = 0;
+    event_init(&sub->event_write);
+    node_init(&sub->node, sub);
+    list_insert_last(&top->subscribers, &sub->node);
+
+    CRITICAL_EXIT();
+}
+
+/**
+ * Unsubscribe from the topic.
+ */
+void topic_unsubscribe(subscriber_t *sub) {
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(priority_bitmap_get_highest(&sub->event_write.priorities) < 0,
+        "Cannot unsubscribe with tasks waiting.");
+
+    CRITICAL_ENTER();
+    list_remove(&sub->node);
+    CRITICAL_EXIT();
+}
+
+/**
+ * Publish an item to all subscribers and resume the tasks waiting for it.
+ * Never fails and never blocks, the oldest item is overwritten.
+ *
+ * @param data Pointer to a buffer with size top->item_size.
+ */
+void topic_publish(topic_t *top, const void *data) {
+    struct node_t *node;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+
+    /* The head wraps modulo the size, the sequence wraps modulo its range. */
+    memcpy(&top->buff[(size_t)top->head * top->item_size], data, top->item_size);
+    if (++top->head == top->size)
+        top->head = 0;
+    top->sequence++;
+
+    for (node = list_get_first(&top->subscribers);
+         node != LIST_HEAD(&top->subscribers);
+         node = node->next) {
+        subscriber_t *sub = (subscriber_t *)node->owner;
+
+        event_resume_all(&sub->event_write);
+    }
+
+    CRITICAL_EXIT();
+    scheduler_unlock();
+}
+
+/**
+ * Read the next item published to the topic.
+ *
+ * If the subscriber fell behind and its next item was overwritten, it skips
+ * ahead to the oldest item kept and adds the items lost to the skipped
+ * count.
+ *
+ * @param data Pointer to a buffer with size top->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t topic_read(subscriber_t *sub, void *data) {
+    topic_t *top = sub->topic;
+    result_t result = LIBRERTOS_FAIL;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (sub->cursor != top->sequence) {
+        topic_seq_t behind = (topic_seq_t)(top->sequence - sub->cursor);
+        size_t slot;
+
+        if (behind > top->size) {
+            sub->skipped = (topic_seq_t)(sub->skipped + (behind - top->size));
+            sub->cursor = (topic_seq_t)(top->sequence - top->size);
+        }
+
+        /* The item is behind items before the head. */
+        behind = (topic_seq_t)(top->sequence - sub->cursor);
+        slot = (size_t)top->head + (behind > top->head ? top->size : 0) - behind;
+        memcpy(data, &top->buff[slot * top->item_size], top->item_size);
+        sub->cursor++;
+
+        result = LIBRERTOS_SUCCESS;
+    }
+
+    CRITICAL_EXIT();
+    return result;
+}
+
+/**
+ * Get the number of items the subscriber skipped because they were
+ * overwritten before it read them.
+ */
+topic_seq_t topic_get_num_skipped(subscriber_t *sub) {
+    topic_seq_t value;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    value = sub->skipped;
+    CRITICAL_EXIT();
+    return value;
+}
+
+/**
+ * Suspend the task waiting for an item published to the topic, waiting a
+ * maximum number for ticks to pass before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ */
+void topic_suspend(subscriber_t *sub, tick_t ticks_to_delay) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    if (sub->cursor == sub->topic->sequence) {
+        scheduler_lock();
+        event_delay_task(&sub->event_write, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
+}
+
+/**
+ * Read the next item published to the topic if there is one, else tries to
+ * suspend the task waiting for it, waiting a maximum number for ticks to pass
+ * before resuming.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size top->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t topic_read_suspend(subscriber_t *sub, void *data, tick_t ticks_to_delay) {
+    result_t result = topic_read(sub, data);
+    if (result == LIBRERTOS_FAIL)
+        topic_suspend(sub, ticks_to_delay);
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_TOPICS */
+
+#if (LIBRERTOS_DISABLE_CHANNELS == 0)
+
+/**
+ * Initialize the channel.
+ *
+ * A channel has no buffer, each item is copied once from the writer to the
+ * reader. A task that cannot complete a transfer registers its buffer and
+ * suspends, and the other side copies directly to or from that buffer and
+ * resumes it. When the task runs again, it calls the same function with the
+ * same buffer, which returns success without copying again.
+ *
+ * The buffers registered by suspended tasks must remain valid while they
+ * wait, so they cannot be local variables of the task function.
+ *
+ * @param item_size Size of the items in the channel.
+ */
+void channel_init(channel_t *chan, item_size_t item_size) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(chan, NONZERO_INITVAL, sizeof(*chan));
+
+    chan->item_size = item_size;
+    event_init(&chan->event_write);
+    event_init(&chan->event_read);
+
+    CRITICAL_EXIT();
+}
+
+/* Copy an item to (or from) the buffer of the first task waiting on the
+ * event, mark its transfer completed and resume it.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static result_t channel_handoff(channel_t *chan, event_t *event, void *data, uint8_t to_task) {
+    task_t *task = event_get_first_task(event);
+
+    if (task == NULL)
+        return LIBRERTOS_FAIL;
+
+    if (to_task)
+        memcpy(task->handoff_data, data, chan->item_size);
+    else
+        memcpy(data, task->handoff_data, chan->item_size);
+
+    event_grant_task(task);
+
+    return LIBRERTOS_SUCCESS;
+}
+
+/* Complete the transfer of the current task, with data handed off while it
+ * was suspended, by the first task waiting on the other side or by
+ * suspending it on the event with its buffer registered.
+ * Call with interrupts disabled and scheduler locked.
+ */
+static result_t channel_transfer_suspend(channel_t *chan, event_t *other, event_t *own, void *data, uint8_t to_task, tick_t ticks_to_delay) {
+    if (event_take_grant(own))
+        return LIBRERTOS_SUCCESS;
+
+    if (channel_handoff(chan, other, data, to_task))
+        return LIBRERTOS_SUCCESS;
+
+    librertos.current_task->handoff_data = data;
+    event_delay_task(own, ticks_to_delay);
+
+    return LIBRERTOS_FAIL;
+}
+
+/**
+ * Read an item from a task waiting to write to the channel.
+ *
+ * @param data Pointer to a buffer with size chan->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t channel_read(channel_t *chan, void *data) {
+    result_t result;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+    result = channel_handoff(chan, &chan->event_read, data, 0);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+    return result;
+}
+
+/**
+ * Write an item directly to the buffer of a task waiting to read the channel.
+ *
+ * @param data Pointer to a buffer with size chan->item_size.
+ * @return 1 with success, 0 otherwise.
+ */
+result_t channel_write(channel_t *chan, const void *data) {
+    result_t result;
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    scheduler_lock();
+    result = channel_handoff(chan, &chan->event_write, (void *)data, 1);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+    return result;
+}
+
+/**
+ * Read an item from a task waiting to write to the channel, else suspend the
+ * task waiting for a writer to copy the item to data, waiting a maximum
+ * number for ticks to pass before resuming.
+ *
+ * When resumed, call again with the same buffer to complete the read.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size chan->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success reading, 0 otherwise.
+ */
+result_t channel_read_suspend(channel_t *chan, void *data, tick_t ticks_to_delay) {
+    result_t result;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+    result = channel_transfer_suspend(chan, &chan->event_read, &chan->event_write, data, 0, ticks_to_delay);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+    return result;
+}
+
+/**
+ * Write an item directly to the buffer of a task waiting to read the channel,
+ * else suspend the task waiting for a reader to copy the item from data,
+ * waiting a maximum number for ticks to pass before resuming.
+ *
+ * When resumed, call again with the same buffer to complete the write.
+ *
+ * This function can be used only by tasks.
+ *
+ * @param data Pointer to a buffer with size chan->item_size.
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 with success writing, 0 otherwise.
+ */
+result_t channel_write_suspend(channel_t *chan, const void *data, tick_t ticks_to_delay) {
+    result_t result;
+    CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
+    CRITICAL_ENTER();
+    scheduler_lock();
+    result = channel_transfer_suspend(chan, &chan->event_write, &chan->event_read, (void *)data, 1, ticks_to_delay);
+    CRITICAL_EXIT();
+    scheduler_unlock();
+    return result;
+}
+
+#endif /* LIBRERTOS_DISABLE_CHANNELS */
+
+#if (LIBRERTOS_DISABLE_EVENT_GROUPS == 0)
+
+/* Flags of the wait condition kept in task_t. */
+enum {
+    EVENT_GROUP_WAIT_ALL = 1,
+    EVENT_GROUP_CLEAR_ON_EXIT = 2
+};
+
+/**
+ * Initialize the event group with all bits cleared.
+ *
+ * The tasks waiting on the group keep their condition (the mask and whether
+ * all or any bit of it must be set) in task_t, so that setting bits checks
+ * only the tasks waiting on this group. All tasks whose condition is met are
+ * resumed in one pass, with the bits that met it.
+ */
+void event_group_init(event_group_t *grp) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(grp, NONZERO_INITVAL, sizeof(*grp));
+
+    grp->bits = 0;
+    event_init(&grp->event_write);
+
+    /* All tasks whose condition is met are resumed, so a single list in
+     * arrival order suffices.
+     */
+    event_set_policy(&grp->event_write, EVENT_POLICY_FIFO);
 
     CRITICAL_EXIT();
 }
 
 /* Call with interrupts disabled. */
-static uint8_t mutex_can_be_locked(mutex_t *mtx, task_t *current_task) {
-    return (mtx->count == MUTEX_UNLOCKED ||
-            (current_task == mtx->task_owner && current_task != NULL));
+static uint8_t event_group_is_met(event_bits_t bits, event_bits_t mask, uint8_t flags) {
+    if (flags & EVENT_GROUP_WAIT_ALL)
+        return (bits & mask) == mask;
+    else
+        return (bits & mask) != 0;
 }
 
 /**
- * Lock the mutex.
+ * Set bits of the event group and resume all tasks whose condition became
+ * true, granting each of them the bits that met it. The bits of the tasks
+ * that clear on exit are cleared after all of them are checked.
  *
- * @return 1 with success, 0 otherwise.
+ * Can be used by tasks and interrupts.
+ *
+ * @param bits Bits to set.
  */
-result_t mutex_lock(mutex_t *mtx) {
-    result_t result = LIBRERTOS_FAIL;
-    task_t *current_task;
+void event_group_set(event_group_t *grp, event_bits_t bits) {
+    struct list_t *list = &grp->event_write.suspended_tasks[0];
+    struct node_t *node;
+    event_bits_t clear_bits = 0;
     CRITICAL_VAL();
     CRITICAL_ENTER();
+    scheduler_lock();
 
-    current_task = librertos.current_task;
-
-    if (mutex_can_be_locked(mtx, current_task)) {
-        mtx->count++;
-        mtx->task_owner = current_task;
-        result = LIBRERTOS_SUCCESS;
-    }
-
-    CRITICAL_EXIT();
-    return result;
-}
+    grp->bits |= bits;
 
-/* Call with interrupts disabled. */
-static void task_set_priority(task_t *task, int8_t priority) {
-    struct list_t *ready_list = &librertos.tasks_ready[task->priority];
-    event_t *event_list = (event_t *)task->event_node.list;
+    for (node = list->head; node != LIST_HEAD(list);) {
+        task_t *task = (task_t *)node->owner;
 
-    task->priority = priority;
+        /* Resuming the task removes the node from the list. */
+        node = node->next;
 
-    if (task->sched_node.list == ready_list) {
-        /* Put in the correct ready list. */
-        list_remove(&task->sched_node);
-        list_insert_first(&librertos.tasks_ready[priority], &task->sched_node);
+        if (event_group_is_met(grp->bits, task->wait_bits, task->wait_flags)) {
+            if (task->wait_flags & EVENT_GROUP_CLEAR_ON_EXIT)
+                clear_bits |= task->wait_bits;
+            task->wait_bits = grp->bits;
+            event_grant_task(task);
+        }
     }
 
-    if (event_list != NULL) {
-        /* Put the task in the correct place in the event list. Keep it
-         * suspended or delayed.
-         */
-
-        task_t *current_task = librertos.current_task;
-        librertos.current_task = task;
-
-        list_remove(&task->event_node);
-        event_add_task_to_event(event_list);
+    grp->bits &= (event_bits_t)~clear_bits;
 
-        librertos.current_task = current_task;
-    }
+    CRITICAL_EXIT();
+    scheduler_unlock();
 }
 
 /**
- * Unlock the mutex.
+ * Clear bits of the event group.
+ *
+ * Can be used by tasks and interrupts.
+ *
+ * @param bits Bits to clear.
+ * @return Bits of the group before clearing.
  */
-void mutex_unlock(mutex_t *mtx) {
+event_bits_t event_group_clear(event_group_t *grp, event_bits_t bits) {
+    event_bits_t value;
     CRITICAL_VAL();
-
-    LIBRERTOS_ASSERT(mtx->count != MUTEX_UNLOCKED, "Mutex already unlocked.");
-
     CRITICAL_ENTER();
-
-    if (mtx->count != MUTEX_UNLOCKED) {
-        mtx->count--;
-    }
-
-    if (mtx->count == MUTEX_UNLOCKED) {
-        task_t *owner;
-
-        scheduler_lock();
-
-        owner = (task_t *)mtx->task_owner;
-
-        if (owner == NULL) {
-            /* Cannot change priority if no task or interrupt. */
-        } else {
-            if (owner->priority != owner->original_priority)
-                task_set_priority(owner, owner->original_priority);
-            mtx->task_owner = NULL;
-        }
-
-        event_resume_task(&mtx->event_unlock);
-        CRITICAL_EXIT();
-        scheduler_unlock();
-    } else {
-        CRITICAL_EXIT();
-    }
+    value = grp->bits;
+    grp->bits &= (event_bits_t)~bits;
+    CRITICAL_EXIT();
+    return value;
 }
 
 /**
- * Check if the mutex is locked.
+ * Get the bits of the event group.
  */
-uint8_t mutex_is_locked(mutex_t *mtx) {
-    uint8_t locked;
+event_bits_t event_group_get(event_group_t *grp) {
+    event_bits_t value;
     CRITICAL_VAL();
     CRITICAL_ENTER();
-    locked = !mutex_can_be_locked(mtx, librertos.current_task);
+    value = grp->bits;
     CRITICAL_EXIT();
-    return locked;
+    return value;
 }
 
 /**
- * Suspend the task on the mutex, waiting a maximum number for ticks to pass
- * before resuming.
+ * Check whether the bits of the mask are set in the event group, else
+ * suspend the task waiting for them, waiting a maximum number for ticks to
+ * pass before resuming.
+ *
+ * When resumed because the condition was met, the task calls the function
+ * again, with the same arguments, to get the bits that met it.
  *
  * This function can be used only by tasks.
  *
+ * @param mask Bits to wait for, non-zero.
+ * @param wait_all 1 to wait for all bits of the mask, 0 for any of them.
+ * @param clear_on_exit 1 to clear the bits of the mask when the condition
+ * is met, 0 to leave them set.
  * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
  * MAX_DELAY to wait forever.
+ * @return Bits of the group when the condition was met, 0 if it was not.
  */
-void mutex_suspend(mutex_t *mtx, tick_t ticks_to_delay) {
+event_bits_t event_group_wait(event_group_t *grp, event_bits_t mask, uint8_t wait_all, uint8_t clear_on_exit, tick_t ticks_to_delay) {
+    event_bits_t value = 0;
+    uint8_t flags = (uint8_t)((wait_all ? EVENT_GROUP_WAIT_ALL : 0) |
+                              (clear_on_exit ? EVENT_GROUP_CLEAR_ON_EXIT : 0));
     CRITICAL_VAL();
-    CRITICAL_ENTER();
-
-    if (!mutex_can_be_locked(mtx, librertos.current_task)) {
-        task_t *owner = (task_t *)mtx->task_owner;
-        int8_t current_priority = librertos.current_task->priority;
-
-        scheduler_lock();
 
-        if (owner == NULL) {
-            /* Cannot change priority of no task or interrupt. */
-        } else {
-            if (owner->priority < current_priority)
-                task_set_priority(owner, current_priority);
-        }
+    LIBRERTOS_ASSERT(mask != 0, "Invalid event group mask.");
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
 
-        event_delay_task(&mtx->event_unlock, ticks_to_delay);
+    CRITICAL_ENTER();
 
+    if (event_take_grant(&grp->event_write)) {
+        value = librertos.current_task->wait_bits;
+        CRITICAL_EXIT();
+    } else if (event_group_is_met(grp->bits, mask, flags)) {
+        value = grp->bits;
+        if (clear_on_exit)
+            grp->bits &= (event_bits_t)~mask;
         CRITICAL_EXIT();
-        scheduler_unlock();
     } else {
+        scheduler_lock();
+        librertos.current_task->wait_bits = mask;
+        librertos.current_task->wait_flags = flags;
+        event_delay_task(&grp->event_write, ticks_to_delay);
         CRITICAL_EXIT();
+        scheduler_unlock();
     }
-}
 
-/**
- * Lock the mutex if unlocked, else tries to suspend the task on the
- * mutex, waiting a maximum number for ticks to pass before resuming.
- *
- * This function can be used only by tasks.
- *
- * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
- * MAX_DELAY to wait forever.
- * @return 1 with success locking, 0 otherwise.
- */
-result_t mutex_lock_suspend(mutex_t *mtx, tick_t ticks_to_delay) {
-    result_t result = mutex_lock(mtx);
-    if (result == LIBRERTOS_FAIL)
-        mutex_suspend(mtx, ticks_to_delay);
-    return result;
+    return value;
 }
 
-#endif /* LIBRERTOS_DISABLE_MUTEXES */
+#endif /* LIBRERTOS_DISABLE_EVENT_GROUPS */
 
-#if (LIBRERTOS_DISABLE_QUEUES == 0)
+#if (LIBRERTOS_DISABLE_BARRIERS == 0)
 
 /**
- * Initialize the queue.
+ * Initialize the cyclic barrier.
  *
- * @param buff Pointer to a buffer with size que_size*item_size.
- * @param que_size Number of items the queue can hold.
- * @param item_size Size of the items in the queue.
+ * Each task calls barrier_wait() when it arrives, which counts it and
+ * suspends it. The last task to arrive releases all of them in one pass and
+ * the barrier starts a new cycle. A released task runs again and calls
+ * barrier_wait() again, which returns success without counting it.
+ *
+ * A task resumed by a timeout (or by task_resume()) before the barrier is
+ * released still counts as arrived, calling barrier_wait() again waits
+ * without counting it again, or returns success if the cycle it arrived in
+ * was released meanwhile.
+ *
+ * @param parties Number of tasks that must arrive to release the barrier.
  */
-void queue_init(queue_t *que, void *buff, uint8_t que_size, uint8_t item_size) {
+void barrier_init(barrier_t *bar, sem_count_t parties) {
     CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(parties > 0, "Invalid number of parties.");
+
     CRITICAL_ENTER();
 
     /* Make non-zero, to be easy to spot uninitialized fields. */
-    memset(que, NONZERO_INITVAL, sizeof(*que));
+    memset(bar, NONZERO_INITVAL, sizeof(*bar));
 
-    que->free = que_size;
-    que->used = 0;
-    que->head = 0;
-    que->tail = 0;
-    que->item_size = item_size;
-    que->end = que_size * item_size;
-    que->buff = (uint8_t *)buff;
-    event_init(&que->event_write);
+    bar->parties = parties;
+    bar->arrived = 0;
+    bar->generation = 0;
+    event_init(&bar->event_release);
 
     CRITICAL_EXIT();
 }
 
-/* Call with interrupts disabled. */
-static uint8_t queue_can_be_read(queue_t *que) {
-    return que->used > 0;
-}
-
-/* Call with interrupts disabled. */
-static uint8_t queue_can_be_written(queue_t *que) {
-    return que->free > 0;
-}
-
 /**
- * Read an item from the queue.
+ * Arrive at the barrier and suspend the task until the last task arrives,
+ * waiting a maximum number for ticks to pass before resuming.
  *
- * @param data Pointer to a buffer with size que->item_size.
- * @return 1 with success, 0 otherwise.
+ * This function can be used only by tasks.
+ *
+ * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
+ * MAX_DELAY to wait forever.
+ * @return 1 if released by the last task to arrive (or is the last one), 0
+ * otherwise.
  */
-result_t queue_read(queue_t *que, void *data) {
+result_t barrier_wait(barrier_t *bar, tick_t ticks_to_delay) {
     result_t result = LIBRERTOS_FAIL;
+    task_t *task = librertos.current_task;
     CRITICAL_VAL();
-    CRITICAL_ENTER();
-
-    if (queue_can_be_read(que)) {
-        memcpy(data, &que->buff[que->tail], que->item_size);
 
-        que->tail += que->item_size;
-        if (que->tail >= que->end)
-            que->tail = 0;
-
-        que->free++;
-        que->used--;
-        result = LIBRERTOS_SUCCESS;
-    }
-
-    CRITICAL_EXIT();
-    return result;
-}
+    LIBRERTOS_ASSERT(task != NULL, "Cannot delay without a task.");
 
-/**
- * Write an item to the queue.
- *
- * @param data Pointer to a buffer with size que->item_size.
- * @return 1 with success, 0 otherwise.
- */
-result_t queue_write(queue_t *que, const void *data) {
-    result_t result = LIBRERTOS_FAIL;
-    CRITICAL_VAL();
     CRITICAL_ENTER();
 
-    if (queue_can_be_written(que)) {
+    if (event_take_grant(&bar->event_release)) {
+        /* Released by the last task to arrive. */
+        result = LIBRERTOS_SUCCESS;
+        CRITICAL_EXIT();
+    } else if (task->event == &bar->event_release && task->barrier_generation != bar->generation) {
+        /* Resumed before the release of the cycle it arrived in. */
+        task->event = NULL;
+        result = LIBRERTOS_SUCCESS;
+        CRITICAL_EXIT();
+    } else if (task->event == &bar->event_release) {
+        /* Arrived in this cycle and resumed before the release. */
+        scheduler_lock();
+        event_delay_task(&bar->event_release, ticks_to_delay);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else if (++bar->arrived == bar->parties) {
+        /* Last to arrive, release all tasks and start a new cycle. */
         scheduler_lock();
 
-        memcpy(&que->buff[que->head], data, que->item_size);
+        bar->arrived = 0;
+        bar->generation++;
 
-        que->head += que->item_size;
-        if (que->head >= que->end)
-            que->head = 0;
+        while ((task = event_get_first_task(&bar->event_release)) != NULL)
+            event_grant_task(task);
 
-        que->free--;
-        que->used++;
         result = LIBRERTOS_SUCCESS;
 
-        event_resume_task(&que->event_write);
-
         CRITICAL_EXIT();
         scheduler_unlock();
     } else {
+        scheduler_lock();
+        task->barrier_generation = bar->generation;
+        event_delay_task(&bar->event_release, ticks_to_delay);
         CRITICAL_EXIT();
+        scheduler_unlock();
     }
 
     return result;
 }
 
 /**
- * Get number of free items in the queue.
+ * Get the number of tasks that arrived at the barrier in this cycle.
  */
-uint8_t queue_get_num_free(queue_t *que) {
-    uint8_t value;
+sem_count_t barrier_get_num_arrived(barrier_t *bar) {
+    sem_count_t value;
     CRITICAL_VAL();
     CRITICAL_ENTER();
-    value = que->free;
+    value = bar->arrived;
     CRITICAL_EXIT();
     return value;
 }
 
 /**
- * Get number of used items in the queue.
+ * Initialize the countdown latch.
+ *
+ * The latch opens when latch_count_down() is called count times, releasing
+ * all waiting tasks at once, and stays open.
+ *
+ * @param count Number of count downs to open the latch.
  */
-uint8_t queue_get_num_used(queue_t *que) {
-    uint8_t value;
+void latch_init(latch_t *lat, sem_count_t count) {
     CRITICAL_VAL();
     CRITICAL_ENTER();
-    value = que->used;
+
+    /* Make non-zero, to be easy to spot uninitialized fields. */
+    memset(lat, NONZERO_INITVAL, sizeof(*lat));
+
+    lat->count = count;
+    event_init(&lat->event_release);
+
     CRITICAL_EXIT();
-    return value;
 }
 
 /**
- * Check if the queue is empty (zero items used).
+ * Count down the latch, opening it and resuming all waiting tasks when the
+ * count reaches zero. Does nothing if the latch is open.
+ *
+ * Can be used by tasks and interrupts.
  */
-uint8_t queue_is_empty(queue_t *que) {
-    return queue_get_num_used(que) == 0;
-}
+void latch_count_down(latch_t *lat) {
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
 
-/**
- * Check if the queue is full (all items used).
- */
-uint8_t queue_is_full(queue_t *que) {
-    return queue_get_num_free(que) == 0;
+    if (lat->count != 0 && --lat->count == 0) {
+        scheduler_lock();
+        event_resume_all(&lat->event_release);
+        CRITICAL_EXIT();
+        scheduler_unlock();
+    } else {
+        CRITICAL_EXIT();
+    }
 }
 
 /**
- * Get total number of items in the queue (free + used).
+ * Get the count of the latch, zero if open.
  */
-uint8_t queue_get_num_items(queue_t *que) {
-    uint8_t value;
+sem_count_t latch_get_count(latch_t *lat) {
+    sem_count_t value;
     CRITICAL_VAL();
     CRITICAL_ENTER();
-    value = que->free + que->used;
+    value = lat->count;
     CRITICAL_EXIT();
     return value;
 }
 
 /**
- * Get the size of the items in the queue.
- */
-uint8_t queue_get_item_size(queue_t *que) {
-    /* Queue item size should not change.
-     * Critical section is not necessary. */
-    return que->item_size;
-}
-
-/**
- * Suspend the task waiting to read the queue, waiting a maximum number for
- * ticks to pass before resuming.
+ * Check whether the latch is open, else suspend the task until it opens,
+ * waiting a maximum number for ticks to pass before resuming.
  *
  * This function can be used only by tasks.
  *
  * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
  * MAX_DELAY to wait forever.
+ * @return 1 if open, 0 otherwise.
  */
-void queue_suspend(queue_t *que, tick_t ticks_to_delay) {
+result_t latch_wait(latch_t *lat, tick_t ticks_to_delay) {
+    result_t result = LIBRERTOS_FAIL;
     CRITICAL_VAL();
+
+    LIBRERTOS_ASSERT(librertos.current_task != NULL, "Cannot delay without a task.");
+
     CRITICAL_ENTER();
 
-    if (!queue_can_be_read(que)) {
-        scheduler_lock();
-        event_delay_task(&que->event_write, ticks_to_delay);
+    if (lat->count == 0) {
+        result = LIBRERTOS_SUCCESS;
         CRITICAL_EXIT();
-        scheduler_unlock();
     } else {
+        scheduler_lock();
+        event_delay_task(&lat->event_release, ticks_to_delay);
         CRITICAL_EXIT();
+        scheduler_unlock();
     }
-}
 
-/**
- * Read an item from the the queue if not empty, else tries to suspend the task
- * waiting to read the queue, waiting a maximum number for ticks to pass before
- * resuming.
- *
- * This function can be used only by tasks.
- *
- * @param data Pointer to a buffer with size que->item_size.
- * @param ticks_to_delay Number of ticks to delay resuming the task. Pass
- * MAX_DELAY to wait forever.
- * @return 1 with success reading, 0 otherwise.
- */
-result_t queue_read_suspend(queue_t *que, void *data, tick_t ticks_to_delay) {
-    result_t result = queue_read(que, data);
-    if (result == LIBRERTOS_FAIL)
-        queue_suspend(que, ticks_to_delay);
     return result;
 }
 
-#endif /* LIBRERTOS_DISABLE_QUEUES */
+#endif /* LIBRERTOS_DISABLE_BARRIERS */
@@ -0,0 +1,188 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (Barrier) {
+    barrier_t bar;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1, 2}, NULL, {NULL});
+        barrier_init(&bar, 3);
+    }
+    void teardown() {
+    }
+
+    result_t wait(task_t *task, tick_t ticks) {
+        set_current_task(task);
+        result_t result = barrier_wait(&bar, ticks);
+        set_current_task(NULL);
+        return result;
+    }
+};
+
+TEST(Barrier, Arrive_Suspends) {
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[1], MAX_DELAY));
+
+    test_task_is_suspended(&test.task[0]);
+    test_task_is_suspended(&test.task[1]);
+    LONGS_EQUAL(2, barrier_get_num_arrived(&bar));
+}
+
+TEST(Barrier, LastToArrive_ReleasesAll) {
+    wait(&test.task[0], MAX_DELAY);
+    wait(&test.task[1], MAX_DELAY);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[2], MAX_DELAY));
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    LONGS_EQUAL(0, barrier_get_num_arrived(&bar));
+
+    // Released tasks pass without arriving again.
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], MAX_DELAY));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[1], MAX_DELAY));
+    LONGS_EQUAL(0, barrier_get_num_arrived(&bar));
+}
+
+TEST(Barrier, Cyclic) {
+    for (int cycle = 0; cycle < 3; cycle++) {
+        LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+        LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[1], MAX_DELAY));
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[2], MAX_DELAY));
+
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], MAX_DELAY));
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[1], MAX_DELAY));
+    }
+}
+
+TEST(Barrier, TimedOut_StillArrivedAndWaitsAgain) {
+    wait(&test.task[0], 1);
+    librertos_tick_interrupt();
+    test_task_is_ready(&test.task[0]);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+    LONGS_EQUAL(1, barrier_get_num_arrived(&bar));
+
+    wait(&test.task[1], MAX_DELAY);
+    wait(&test.task[2], MAX_DELAY);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(Barrier, TimedOutBeforeRelease_SucceedsForReleasedCycle) {
+    wait(&test.task[0], 1);
+    librertos_tick_interrupt();
+
+    wait(&test.task[1], MAX_DELAY);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[2], MAX_DELAY));
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], MAX_DELAY));
+    LONGS_EQUAL(0, barrier_get_num_arrived(&bar));
+
+    // The next call arrives in the new cycle.
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+    LONGS_EQUAL(1, barrier_get_num_arrived(&bar));
+}
+
+TEST(Barrier, InvalidParties_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Invalid number of parties.");
+
+    CHECK_THROWS(AssertionError, barrier_init(&bar, 0));
+}
+
+TEST(Barrier, WaitWithoutTask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(AssertionError, barrier_wait(&bar, MAX_DELAY));
+}
+
+TEST_GROUP (Latch) {
+    latch_t lat;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1}, NULL, {NULL});
+        latch_init(&lat, 2);
+    }
+    void teardown() {
+    }
+
+    result_t wait(task_t *task, tick_t ticks) {
+        set_current_task(task);
+        result_t result = latch_wait(&lat, ticks);
+        set_current_task(NULL);
+        return result;
+    }
+};
+
+TEST(Latch, Closed_Suspends) {
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(Latch, CountDownToZero_ReleasesAll) {
+    wait(&test.task[0], MAX_DELAY);
+    wait(&test.task[1], MAX_DELAY);
+
+    latch_count_down(&lat);
+    test_task_is_suspended(&test.task[0]);
+    test_task_is_suspended(&test.task[1]);
+    LONGS_EQUAL(1, latch_get_count(&lat));
+
+    latch_count_down(&lat);
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    LONGS_EQUAL(0, latch_get_count(&lat));
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], MAX_DELAY));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[1], MAX_DELAY));
+}
+
+TEST(Latch, Open_StaysOpen) {
+    latch_count_down(&lat);
+    latch_count_down(&lat);
+    latch_count_down(&lat);
+
+    LONGS_EQUAL(0, latch_get_count(&lat));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], MAX_DELAY));
+}
+
+TEST(Latch, CountDownFromInterrupt_ReleasesAll) {
+    wait(&test.task[0], MAX_DELAY);
+
+    task_t *interrupted_task = interrupt_lock();
+    latch_count_down(&lat);
+    latch_count_down(&lat);
+    interrupt_unlock(interrupted_task);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(Latch, Delayed_ResumesWithTickInterrupt) {
+    wait(&test.task[0], 1);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], MAX_DELAY));
+}
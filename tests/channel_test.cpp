@@ -0,0 +1,162 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+static struct
+{
+    channel_t chan;
+    uint16_t data;
+    int reads;
+} testx;
+
+static void func_reader(void *) {
+    if (channel_read_suspend(&testx.chan, &testx.data, MAX_DELAY))
+        testx.reads++;
+}
+
+TEST_GROUP (Channel) {
+    void setup() {
+        test_init();
+        channel_init(&testx.chan, sizeof(uint16_t));
+        testx.data = 0;
+        testx.reads = 0;
+    }
+    void teardown() {
+    }
+};
+
+TEST(Channel, NoReader_CannotWrite) {
+    uint16_t data = 5;
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_write(&testx.chan, &data));
+}
+
+TEST(Channel, NoWriter_CannotRead) {
+    uint16_t data = 0;
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_read(&testx.chan, &data));
+}
+
+TEST(Channel, ReaderWaiting_WriteCopiesToItsBuffer) {
+    uint16_t data = 1234;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_read_suspend(&testx.chan, &testx.data, MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_write(&testx.chan, &data));
+
+    LONGS_EQUAL(1234, testx.data);
+    test_task_is_ready(&test.task[0]);
+
+    // Completes the read without copying again.
+    testx.data = 0;
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_read_suspend(&testx.chan, &testx.data, MAX_DELAY));
+    set_current_task(NULL);
+
+    LONGS_EQUAL(0, testx.data);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(Channel, WriterWaiting_ReadCopiesFromItsBuffer) {
+    static uint16_t data_w = 1234;
+    uint16_t data_r = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_write_suspend(&testx.chan, &data_w, MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_read(&testx.chan, &data_r));
+
+    LONGS_EQUAL(1234, data_r);
+    test_task_is_ready(&test.task[0]);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_write_suspend(&testx.chan, &data_w, MAX_DELAY));
+    set_current_task(NULL);
+
+    // Nothing left for another reader.
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_read(&testx.chan, &data_r));
+}
+
+TEST(Channel, ReaderAndWriterSuspend_Rendezvous) {
+    static uint16_t data_w = 77;
+
+    test_create_tasks({0, 1}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_read_suspend(&testx.chan, &testx.data, MAX_DELAY));
+    set_current_task(&test.task[1]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_write_suspend(&testx.chan, &data_w, MAX_DELAY));
+    set_current_task(NULL);
+
+    LONGS_EQUAL(77, testx.data);
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+}
+
+TEST(Channel, ReaderTask_RunsOncePerItem) {
+    uint16_t data = 42;
+
+    test_create_tasks({0}, &func_reader, {NULL});
+
+    librertos_start();
+    librertos_sched();
+    LONGS_EQUAL(0, testx.reads);
+    test_task_is_suspended(&test.task[0]);
+
+    // Preempts, completes the read, runs again and suspends waiting for the
+    // next item.
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, channel_write(&testx.chan, &data));
+
+    LONGS_EQUAL(1, testx.reads);
+    LONGS_EQUAL(42, testx.data);
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(Channel, ReaderTimesOut_WriteFails) {
+    uint16_t data = 5;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    channel_read_suspend(&testx.chan, &testx.data, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, channel_write(&testx.chan, &data));
+}
+
+TEST(Channel, SuspendWithoutTask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(
+        AssertionError,
+        channel_read_suspend(&testx.chan, &testx.data, MAX_DELAY));
+}
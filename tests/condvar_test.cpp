@@ -0,0 +1,192 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (CondVar) {
+    mutex_t mtx;
+    condvar_t cv;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1, 2}, NULL, {NULL});
+        mutex_init(&mtx);
+        condvar_init(&cv, &mtx);
+    }
+    void teardown() {
+    }
+
+    result_t lock(task_t *task) {
+        set_current_task(task);
+        result_t result = mutex_lock_suspend(&mtx, MAX_DELAY);
+        set_current_task(NULL);
+        return result;
+    }
+
+    void unlock(task_t *task) {
+        set_current_task(task);
+        mutex_unlock(&mtx);
+        set_current_task(NULL);
+    }
+
+    void wait(task_t *task, tick_t ticks) {
+        set_current_task(task);
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, mutex_lock(&mtx));
+        condvar_wait(&cv, ticks);
+        set_current_task(NULL);
+    }
+};
+
+TEST(CondVar, Wait_UnlocksMutexAndSuspends) {
+    wait(&test.task[0], MAX_DELAY);
+
+    test_task_is_suspended(&test.task[0]);
+    LONGS_EQUAL(0, mutex_is_locked(&mtx));
+}
+
+TEST(CondVar, SignalNoTask_DoesNothing) {
+    condvar_signal(&cv);
+    condvar_broadcast(&cv);
+
+    LONGS_EQUAL(0, mutex_is_locked(&mtx));
+}
+
+TEST(CondVar, SignalMutexUnlocked_GrantsMutex) {
+    wait(&test.task[0], MAX_DELAY);
+
+    condvar_signal(&cv);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(LIBRERTOS_FAIL, lock(&test.task[1]));
+
+    // Locks without suspending again.
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[0]));
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(CondVar, SignalMutexLocked_ResumesTaskWhenUnlocked) {
+    wait(&test.task[0], MAX_DELAY);
+    lock(&test.task[1]);
+
+    condvar_signal(&cv);
+    test_task_is_suspended(&test.task[0]);
+
+    unlock(&test.task[1]);
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_RESUMED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[0]));
+}
+
+TEST(CondVar, SignalMutexLockedWithHandoff_GrantsMutexWhenUnlocked) {
+    mutex_set_handoff(&mtx, 1);
+    wait(&test.task[0], MAX_DELAY);
+    lock(&test.task[1]);
+
+    condvar_signal(&cv);
+
+    unlock(&test.task[1]);
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(LIBRERTOS_FAIL, lock(&test.task[2]));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[0]));
+}
+
+TEST(CondVar, Init_KeepsHandoffModeOfMutex) {
+    lock(&test.task[1]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, lock(&test.task[0]));
+
+    unlock(&test.task[1]);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_RESUMED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(0, mutex_is_locked(&mtx));
+}
+
+TEST(CondVar, Signal_WakesOnlyFirstTask) {
+    wait(&test.task[0], MAX_DELAY);
+    wait(&test.task[2], MAX_DELAY);
+
+    condvar_signal(&cv);
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(CondVar, Broadcast_TasksGetMutexOneAtATime) {
+    wait(&test.task[0], MAX_DELAY);
+    wait(&test.task[2], MAX_DELAY);
+
+    condvar_broadcast(&cv);
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_suspended(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[2]));
+
+    unlock(&test.task[2]);
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[0]));
+}
+
+TEST(CondVar, SignalMutexLocked_OwnerInheritsPriority) {
+    wait(&test.task[2], MAX_DELAY);
+    lock(&test.task[0]);
+
+    condvar_signal(&cv);
+    LONGS_EQUAL(2, test.task[0].priority);
+
+    unlock(&test.task[0]);
+    LONGS_EQUAL(0, test.task[0].priority);
+    test_task_is_ready(&test.task[2]);
+}
+
+TEST(CondVar, SignalFromInterrupt_GrantsMutex) {
+    wait(&test.task[0], MAX_DELAY);
+
+    task_t *interrupted_task = interrupt_lock();
+    condvar_signal(&cv);
+    interrupt_unlock(interrupted_task);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock(&test.task[0]));
+}
+
+TEST(CondVar, Delayed_ResumesWithTickInterrupt) {
+    wait(&test.task[0], 1);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_TIMED_OUT, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(0, mutex_is_locked(&mtx));
+}
+
+TEST(CondVar, WaitWithoutMutex_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "The task must lock the mutex once.");
+
+    set_current_task(&test.task[0]);
+    CHECK_THROWS(AssertionError, condvar_wait(&cv, MAX_DELAY));
+}
+
+TEST(CondVar, WaitWithoutTask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(AssertionError, condvar_wait(&cv, MAX_DELAY));
+}
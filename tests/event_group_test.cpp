@@ -0,0 +1,185 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (EventGroup) {
+    event_group_t grp;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1, 2}, NULL, {NULL});
+        event_group_init(&grp);
+    }
+    void teardown() {
+    }
+
+    event_bits_t wait(task_t *task, event_bits_t mask, uint8_t wait_all, uint8_t clear_on_exit, tick_t ticks) {
+        set_current_task(task);
+        event_bits_t value = event_group_wait(&grp, mask, wait_all, clear_on_exit, ticks);
+        set_current_task(NULL);
+        return value;
+    }
+};
+
+TEST(EventGroup, Init_AllBitsCleared) {
+    LONGS_EQUAL(0, event_group_get(&grp));
+}
+
+TEST(EventGroup, SetAndClear) {
+    event_group_set(&grp, 0x05);
+    LONGS_EQUAL(0x05, event_group_get(&grp));
+
+    LONGS_EQUAL(0x05, event_group_clear(&grp, 0x01));
+    LONGS_EQUAL(0x04, event_group_get(&grp));
+}
+
+TEST(EventGroup, ConditionMet_DoesNotSuspend) {
+    event_group_set(&grp, 0x03);
+
+    LONGS_EQUAL(0x03, wait(&test.task[0], 0x01, 0, 0, MAX_DELAY));
+    LONGS_EQUAL(0x03, wait(&test.task[0], 0x03, 1, 0, MAX_DELAY));
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(0x03, event_group_get(&grp));
+}
+
+TEST(EventGroup, ConditionMet_ClearOnExit) {
+    event_group_set(&grp, 0x07);
+
+    LONGS_EQUAL(0x07, wait(&test.task[0], 0x03, 1, 1, MAX_DELAY));
+    LONGS_EQUAL(0x04, event_group_get(&grp));
+}
+
+TEST(EventGroup, ConditionNotMet_Suspends) {
+    event_group_set(&grp, 0x01);
+
+    LONGS_EQUAL(0, wait(&test.task[0], 0x03, 1, 0, MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(EventGroup, WaitAny_ResumedWithBitsThatMetIt) {
+    wait(&test.task[0], 0x06, 0, 0, MAX_DELAY);
+    test_task_is_suspended(&test.task[0]);
+
+    event_group_set(&grp, 0x01);
+    test_task_is_suspended(&test.task[0]);
+
+    event_group_set(&grp, 0x04);
+    test_task_is_ready(&test.task[0]);
+
+    // The bits change before the task runs again.
+    event_group_clear(&grp, 0x04);
+
+    LONGS_EQUAL(0x05, wait(&test.task[0], 0x06, 0, 0, MAX_DELAY));
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(EventGroup, WaitAll_ResumedWhenAllBitsSet) {
+    wait(&test.task[0], 0x03, 1, 0, MAX_DELAY);
+
+    event_group_set(&grp, 0x01);
+    test_task_is_suspended(&test.task[0]);
+
+    event_group_set(&grp, 0x02);
+    test_task_is_ready(&test.task[0]);
+
+    LONGS_EQUAL(0x03, wait(&test.task[0], 0x03, 1, 0, MAX_DELAY));
+}
+
+TEST(EventGroup, Set_ResumesAllTasksWhoseConditionIsMet) {
+    wait(&test.task[0], 0x01, 0, 0, MAX_DELAY);
+    wait(&test.task[1], 0x02, 0, 0, MAX_DELAY);
+    wait(&test.task[2], 0x03, 1, 0, MAX_DELAY);
+
+    event_group_set(&grp, 0x03);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_ready(&test.task[2]);
+    list_tester(&grp.event_write.suspended_tasks[0], std::vector<node_t *>{});
+}
+
+TEST(EventGroup, Set_OtherTasksKeepWaiting) {
+    wait(&test.task[0], 0x01, 0, 0, MAX_DELAY);
+    wait(&test.task[1], 0x02, 0, 0, MAX_DELAY);
+    wait(&test.task[2], 0x01, 0, 0, MAX_DELAY);
+
+    event_group_set(&grp, 0x01);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_suspended(&test.task[1]);
+    test_task_is_ready(&test.task[2]);
+    list_tester(&grp.event_write.suspended_tasks[0], std::vector<node_t *>{&test.task[1].event_node});
+}
+
+TEST(EventGroup, ClearOnExit_AllWaitersSeeTheSameBits) {
+    wait(&test.task[0], 0x01, 0, 1, MAX_DELAY);
+    wait(&test.task[1], 0x01, 0, 1, MAX_DELAY);
+
+    event_group_set(&grp, 0x03);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    LONGS_EQUAL(0x02, event_group_get(&grp));
+
+    LONGS_EQUAL(0x03, wait(&test.task[0], 0x01, 0, 1, MAX_DELAY));
+    LONGS_EQUAL(0x03, wait(&test.task[1], 0x01, 0, 1, MAX_DELAY));
+}
+
+TEST(EventGroup, Granted_OnlyOnce) {
+    wait(&test.task[0], 0x01, 0, 1, MAX_DELAY);
+    event_group_set(&grp, 0x01);
+
+    LONGS_EQUAL(0x01, wait(&test.task[0], 0x01, 0, 1, MAX_DELAY));
+    LONGS_EQUAL(0, wait(&test.task[0], 0x01, 0, 1, MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(EventGroup, Set_WithInterruptRunning) {
+    wait(&test.task[0], 0x01, 0, 0, MAX_DELAY);
+
+    task_t *interrupted_task = interrupt_lock();
+    event_group_set(&grp, 0x01);
+    interrupt_unlock(interrupted_task);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(EventGroup, Delayed_ResumesWithTickInterrupt) {
+    wait(&test.task[0], 0x01, 0, 0, 1);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_TIMED_OUT, task_get_wake_result(&test.task[0]));
+    list_tester(&grp.event_write.suspended_tasks[0], std::vector<node_t *>{});
+}
+
+TEST(EventGroup, InvalidMask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Invalid event group mask.");
+
+    CHECK_THROWS(AssertionError, wait(&test.task[0], 0, 0, 0, MAX_DELAY));
+}
+
+TEST(EventGroup, WaitWithoutTask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(AssertionError, event_group_wait(&grp, 0x01, 0, 0, MAX_DELAY));
+}
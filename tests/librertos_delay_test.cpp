@@ -29,7 +29,7 @@ TEST(Delay, Delay_SuspendOneTask) {
     set_current_task(task[0]);
     task_delay(1);
 
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[0]->sched_node.list);
+    test_task_is_delayed(task[0]);
 }
 
 TEST(Delay, Delay_SuspendsTwoTasks) {
@@ -41,8 +41,8 @@ TEST(Delay, Delay_SuspendsTwoTasks) {
     set_current_task(task[1]);
     task_delay(2);
 
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
+    test_task_is_delayed(task[0]);
+    test_task_is_delayed(task[1]);
 }
 
 TEST(Delay, TickInterrupt_ResumeOneTask) {
@@ -68,7 +68,7 @@ TEST(Delay, TickInterrupt_ResumeOnlyExpiredTasks) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
+    test_task_is_delayed(task[1]);
 }
 
 TEST(Delay, TickInterrupt_ResumeOnlyExpiredTasks_2) {
@@ -103,7 +103,7 @@ TEST(Delay, TickInterrupt_ResumeMultipleExpiredTasks) {
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 }
 
 TEST(Delay, TickInterrupt_TwoTasks_TimeSequence) {
@@ -118,7 +118,7 @@ TEST(Delay, TickInterrupt_TwoTasks_TimeSequence) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
+    test_task_is_delayed(task[1]);
 
     librertos_tick_interrupt();
 
@@ -137,7 +137,7 @@ TEST(Delay, TickInterrupt_TwoTasks_TimeSequence_2) {
 
     librertos_tick_interrupt();
 
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[0]->sched_node.list);
+    test_task_is_delayed(task[0]);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
 
     librertos_tick_interrupt();
@@ -176,14 +176,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -207,14 +207,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_2) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -238,14 +238,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_3) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -269,14 +269,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_4) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -300,14 +300,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_5) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -331,14 +331,14 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_6) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -363,7 +363,7 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_7) {
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -388,7 +388,7 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_8) {
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -412,8 +412,8 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_9) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -437,8 +437,8 @@ TEST(Delay, TickInterrupt_ThreeTasks_TimeSequence_10) {
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -474,7 +474,7 @@ TEST(Delay, Delay_SuspendOneTask_Overflowed) {
     set_current_task(task[0]);
     task_delay(MAX_DELAY);
 
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[0]->sched_node.list);
+    test_task_is_delayed(task[0]);
 }
 
 TEST(Delay, Delay_SuspendsTwoTasks_Overflowed) {
@@ -488,31 +488,45 @@ TEST(Delay, Delay_SuspendsTwoTasks_Overflowed) {
     set_current_task(task[1]);
     task_delay(MAX_DELAY);
 
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[1]->sched_node.list);
+    test_task_is_delayed(task[0]);
+    test_task_is_delayed(task[1]);
 }
 
-TEST(Delay, TickInterrupt_Overflow_SwapDelayLists) {
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[0], librertos.tasks_delayed_current);
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[1], librertos.tasks_delayed_overflow);
+TEST(Delay, TickInterrupt_LongDelay_CascadesAndResumesOnTime) {
+    auto task = test_create_tasks({0}, NULL, {NULL});
+
+    set_tick(5);
+
+    set_current_task(task[0]);
+    task_delay(300);
+
+    for (int i = 0; i < 299; i++) {
+        librertos_tick_interrupt();
+        test_task_is_delayed(task[0]);
+    }
 
-    time_travel(MAX_DELAY);
     librertos_tick_interrupt();
 
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[1], librertos.tasks_delayed_current);
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[0], librertos.tasks_delayed_overflow);
+    test_task_is_ready(task[0]);
+    LONGS_EQUAL(305, get_tick());
+}
+
+TEST(Delay, TickInterrupt_ZeroDelay_ResumesAfterTickOverflow) {
+    auto task = test_create_tasks({0}, NULL, {NULL});
+
+    set_tick(3);
+
+    set_current_task(task[0]);
+    task_delay(0);
+
+    while (get_tick() != 2) {
+        librertos_tick_interrupt();
+        test_task_is_delayed(task[0]);
+    }
 
-    time_travel(MAX_DELAY);
     librertos_tick_interrupt();
 
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[0], librertos.tasks_delayed_current);
-    POINTERS_EQUAL(
-        &librertos.tasks_delayed[1], librertos.tasks_delayed_overflow);
+    test_task_is_ready(task[0]);
 }
 
 TEST(Delay, TickInterrupt_Overflow_ResumeTasks) {
@@ -529,16 +543,17 @@ TEST(Delay, TickInterrupt_Overflow_ResumeTasks) {
     set_current_task(task[2]);
     task_delay(MAX_DELAY);
 
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[2]->sched_node.list);
+    test_task_is_delayed(task[0]);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
-    set_tick(MAX_DELAY);
+    while (get_tick() != MAX_DELAY)
+        librertos_tick_interrupt();
     librertos_tick_interrupt();
 
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[2]->sched_node.list);
+    test_task_is_delayed(task[2]);
 
     librertos_tick_interrupt();
 
@@ -562,8 +577,8 @@ TEST(Delay, ResumeAllTasks_AlsoResumesDelayedTasks) {
     task_delay(MAX_DELAY);
 
     POINTERS_EQUAL(&librertos.tasks_suspended, task[0]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_current, task[1]->sched_node.list);
-    POINTERS_EQUAL(librertos.tasks_delayed_overflow, task[2]->sched_node.list);
+    test_task_is_delayed(task[1]);
+    test_task_is_delayed(task[2]);
 
     task_resume_all();
 
@@ -571,3 +586,256 @@ TEST(Delay, ResumeAllTasks_AlsoResumesDelayedTasks) {
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[1]->sched_node.list);
     POINTERS_EQUAL(&librertos.tasks_ready[0], task[2]->sched_node.list);
 }
+
+TEST(Delay, GetNextWakeup_NoDelayedTasks_Fails) {
+    tick_t wakeup = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    LONGS_EQUAL(0, get_next_wakeup(&wakeup));
+}
+
+TEST(Delay, GetNextWakeup_SleepsUntilDelayedTask) {
+    auto task = test_create_tasks({0}, NULL, {NULL});
+    tick_t wakeup;
+
+    set_tick(5);
+
+    set_current_task(task[0]);
+    task_delay(300);
+
+    /* Sleep until the wakeup, as a tickless idle would. */
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(305, wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    LONGS_EQUAL(0, get_next_wakeup(&wakeup));
+
+    test_task_is_ready(task[0]);
+    LONGS_EQUAL(305, get_tick());
+}
+
+TEST(Delay, GetNextWakeup_ReturnsEarliestWakeupOfTasks) {
+    auto task = test_create_tasks({0, 0, 0}, NULL, {NULL});
+    tick_t wakeup;
+
+    set_tick(5);
+
+    set_current_task(task[0]);
+    task_delay(1000);
+    set_current_task(task[1]);
+    task_delay(300);
+    set_current_task(task[2]);
+    task_delay(20);
+    set_current_task(NULL);
+
+    /* One wakeup per task, the buckets in between cascade when advancing. */
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(25, wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    test_task_is_ready(task[2]);
+    test_task_is_delayed(task[1]);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(305, wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    test_task_is_ready(task[1]);
+    test_task_is_delayed(task[0]);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(1005, wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    test_task_is_ready(task[0]);
+
+    LONGS_EQUAL(0, get_next_wakeup(&wakeup));
+}
+
+TEST(Delay, GetNextWakeup_WrappedDelayInEarlierBucket_ReturnsEarliestWakeup) {
+    auto task = test_create_tasks({0, 0}, NULL, {NULL});
+    tick_t wakeup;
+
+    /* Wakes up at 0x0420 after the tick counter wraps, in a bucket that is
+     * processed before the wakeup of the other task once the tick reaches
+     * 0x1000.
+     */
+    set_tick(0x0500);
+    set_current_task(task[0]);
+    task_delay(0xFF20);
+    set_current_task(NULL);
+
+    librertos_tick_advance(0x0B00);
+    test_task_is_delayed(task[0]);
+
+    set_current_task(task[1]);
+    task_delay(0x0600);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(0x1600, wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    test_task_is_ready(task[1]);
+    test_task_is_delayed(task[0]);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(0x0420, wakeup);
+    librertos_tick_advance((tick_t)(wakeup - get_tick()));
+    test_task_is_ready(task[0]);
+}
+
+TEST(Delay, GetNextWakeup_FullPeriodDelay) {
+    auto task = test_create_tasks({0}, NULL, {NULL});
+    tick_t wakeup;
+
+    set_tick(5);
+
+    set_current_task(task[0]);
+    task_delay(MAX_DELAY - 1);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL((tick_t)(5 + MAX_DELAY - 1), wakeup);
+    librertos_tick_advance(wakeup - get_tick());
+    test_task_is_ready(task[0]);
+}
+
+TEST(Delay, TickAdvance_Zero_DoesNothing) {
+    auto task = test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(task[0]);
+    task_delay(1);
+
+    librertos_tick_advance(0);
+
+    test_task_is_delayed(task[0]);
+    LONGS_EQUAL(0, get_tick());
+}
+
+TEST(Delay, TickAdvance_ResumeOnlyExpiredTasks) {
+    auto task = test_create_tasks({0, 0, 0}, NULL, {NULL});
+
+    set_current_task(task[0]);
+    task_delay(10);
+
+    set_current_task(task[1]);
+    task_delay(15);
+
+    set_current_task(task[2]);
+    task_delay(300);
+
+    librertos_tick_advance(15);
+
+    test_task_is_ready(task[0]);
+    test_task_is_ready(task[1]);
+    test_task_is_delayed(task[2]);
+    LONGS_EQUAL(15, get_tick());
+
+    librertos_tick_advance(284);
+
+    test_task_is_delayed(task[2]);
+    LONGS_EQUAL(299, get_tick());
+
+    librertos_tick_advance(1);
+
+    test_task_is_ready(task[2]);
+}
+
+TEST(Delay, TickAdvance_NoDelayedTasks_AdvancesTick) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_tick(MAX_DELAY - 1);
+
+    librertos_tick_advance(3);
+
+    LONGS_EQUAL(1, get_tick());
+}
+
+TEST(Delay, TickAdvance_Overflow_ResumeTasks) {
+    auto task = test_create_tasks({0, 1, 0}, NULL, {NULL});
+
+    set_tick(MAX_DELAY - 10);
+
+    set_current_task(task[0]);
+    task_delay(5);
+
+    set_current_task(task[1]);
+    task_delay(20);
+
+    set_current_task(task[2]);
+    task_delay(30);
+
+    set_current_task(NULL);
+
+    librertos_tick_advance(25);
+
+    test_task_is_ready(task[0]);
+    test_task_is_ready(task[1]);
+    test_task_is_delayed(task[2]);
+    LONGS_EQUAL(14, get_tick());
+
+    librertos_tick_advance(5);
+
+    test_task_is_ready(task[2]);
+    LONGS_EQUAL(19, get_tick());
+}
+
+TEST(Delay, TickAdvance_ResumesBatchWithoutRunningTasks) {
+    auto task = test_create_tasks({0, 1, 2}, NULL, {NULL});
+
+    set_current_task(task[0]);
+    task_delay(3);
+
+    set_current_task(task[1]);
+    task_delay(3);
+
+    set_current_task(task[2]);
+    task_delay(3);
+
+    set_current_task(NULL);
+    librertos.higher_priority_task_ready = 0;
+
+    librertos_tick_advance(3);
+
+    /* Ready in their own lists, to run when the scheduler unlocks. */
+    POINTERS_EQUAL(&librertos.tasks_ready[0], task[0]->sched_node.list);
+    POINTERS_EQUAL(&librertos.tasks_ready[1], task[1]->sched_node.list);
+    POINTERS_EQUAL(&librertos.tasks_ready[2], task[2]->sched_node.list);
+    LONGS_EQUAL(1, librertos.higher_priority_task_ready);
+    LONGS_EQUAL(2, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
+
+TEST(Delay, TickInterrupt_SplicesExpiredBucketInOrder) {
+    auto task = test_create_tasks({1, 1, 0, 1}, NULL, {NULL});
+
+    for (int i = 0; i < 4; i++) {
+        set_current_task(task[i]);
+        task_delay(2);
+    }
+    set_current_task(NULL);
+
+    librertos_tick_interrupt();
+    librertos_tick_interrupt();
+
+    /* Each run of the same priority keeps the order of delaying. */
+    list_tester(&librertos.tasks_ready[1], {&task[0]->sched_node, &task[1]->sched_node, &task[3]->sched_node});
+    list_tester(&librertos.tasks_ready[0], {&task[2]->sched_node});
+    LONGS_EQUAL(0, librertos.delayed_buckets[0]);
+}
+
+TEST(Delay, GetNextWakeup_DelayedTaskResumed_IgnoresEmptyBucket) {
+    auto task = test_create_tasks({0, 0}, NULL, {NULL});
+    tick_t wakeup;
+
+    set_current_task(task[0]);
+    task_delay(3);
+    set_current_task(task[1]);
+    task_delay(7);
+    set_current_task(NULL);
+
+    task_resume(task[0]);
+
+    LONGS_EQUAL(1, get_next_wakeup(&wakeup));
+    LONGS_EQUAL(7, wakeup);
+
+    task_resume(task[1]);
+
+    LONGS_EQUAL(0, get_next_wakeup(&wakeup));
+}
@@ -120,9 +120,8 @@ TEST(Event, TwoTasksSuspendOnTheSameEvent_BothSuspend) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{&task2.event_node, &task1.event_node});
+    event_tester(
+        &event, std::vector<node_t *>{&task2.event_node, &task1.event_node});
 
     librertos_sched();
     STRCMP_EQUAL("", buff);
@@ -144,9 +143,8 @@ TEST(Event, TwoTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{&task2.event_node, &task1.event_node});
+    event_tester(
+        &event, std::vector<node_t *>{&task2.event_node, &task1.event_node});
 
     librertos_sched();
     STRCMP_EQUAL("", buff);
@@ -155,14 +153,14 @@ TEST(Event, TwoTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst) {
     librertos_sched();
     STRCMP_EQUAL("abc", buff);
 
-    list_tester(
-        &event.suspended_tasks, std::vector<node_t *>{&task1.event_node});
+    event_tester(
+        &event, std::vector<node_t *>{&task1.event_node});
 
     event_resume_task(&event);
     librertos_sched();
     STRCMP_EQUAL("abcABC", buff);
 
-    list_tester(&event.suspended_tasks, std::vector<node_t *>{});
+    event_tester(&event, std::vector<node_t *>{});
 }
 
 TEST(Event, TwoTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_2) {
@@ -181,9 +179,8 @@ TEST(Event, TwoTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_2) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{&task2.event_node, &task1.event_node});
+    event_tester(
+        &event, std::vector<node_t *>{&task2.event_node, &task1.event_node});
 
     librertos_sched();
     STRCMP_EQUAL("", buff);
@@ -192,14 +189,14 @@ TEST(Event, TwoTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_2) {
     librertos_sched();
     STRCMP_EQUAL("abc", buff);
 
-    list_tester(
-        &event.suspended_tasks, std::vector<node_t *>{&task1.event_node});
+    event_tester(
+        &event, std::vector<node_t *>{&task1.event_node});
 
     event_resume_task(&event);
     librertos_sched();
     STRCMP_EQUAL("abcABC", buff);
 
-    list_tester(&event.suspended_tasks, std::vector<node_t *>{});
+    event_tester(&event, std::vector<node_t *>{});
 }
 
 TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst) {
@@ -223,9 +220,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -265,9 +261,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_2) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -307,9 +302,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_3) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -349,9 +343,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_4) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -391,9 +384,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_5) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -433,9 +425,8 @@ TEST(Event, ThreeTasksSuspendOnTheSameEvent_HigherPriorityResumesFirst_6) {
 
     set_current_task(NULL);
 
-    list_tester(
-        &event.suspended_tasks,
-        std::vector<node_t *>{
+    event_tester(
+        &event, std::vector<node_t *>{
             &task3.event_node, &task2.event_node, &task1.event_node});
 
     librertos_sched();
@@ -497,7 +488,7 @@ TEST(EventNewTest, TaskDelaysOnEvent_ResumesWithTaskResume) {
     set_current_task(&test.task[0]);
     event_delay_task(&event, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     task_resume(&test.task[0]);
 
@@ -510,7 +501,7 @@ TEST(EventNewTest, TaskDelaysOnEvent_ResumesWithEvent) {
     set_current_task(&test.task[0]);
     event_delay_task(&event, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     event_resume_task(&event);
 
@@ -523,7 +514,7 @@ TEST(EventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt) {
     set_current_task(&test.task[0]);
     event_delay_task(&event, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
@@ -536,11 +527,11 @@ TEST(EventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt_2) {
     set_current_task(&test.task[0]);
     event_delay_task(&event, 2);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
@@ -554,18 +545,89 @@ TEST(EventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt_3) {
     set_current_task(&test.task[0]);
     event_delay_task(&event, MAX_DELAY - 1);
 
-    test_task_is_delayed_overflow(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     set_tick(MAX_DELAY - 1);
     librertos_tick_interrupt();
 
-    test_task_is_delayed_overflow(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
     test_task_is_ready(&test.task[0]);
 }
+
+TEST(EventNewTest, SamePriority_ResumesInFifoOrder) {
+    auto task = test_create_tasks({1, 2, 1, 1}, NULL, {NULL});
+
+    for (int i = 0; i < 4; i++) {
+        set_current_task(task[i]);
+        event_delay_task(&event, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    event_tester(
+        &event,
+        std::vector<node_t *>{
+            &task[1]->event_node,
+            &task[0]->event_node,
+            &task[2]->event_node,
+            &task[3]->event_node});
+
+    event_resume_task(&event);
+    test_task_is_ready(task[1]);
+
+    event_resume_task(&event);
+    test_task_is_ready(task[0]);
+    test_task_is_suspended(task[2]);
+
+    event_resume_task(&event);
+    test_task_is_ready(task[2]);
+    test_task_is_suspended(task[3]);
+
+    event_tester(&event, std::vector<node_t *>{&task[3]->event_node});
+}
+
+TEST(EventNewTest, TaskResumedByOther_RemovedFromEvent) {
+    auto task = test_create_tasks({1, 1}, NULL, {NULL});
+
+    set_current_task(task[0]);
+    event_delay_task(&event, MAX_DELAY);
+    set_current_task(task[1]);
+    event_delay_task(&event, 5);
+    set_current_task(NULL);
+
+    task_resume(task[0]);
+    event_tester(&event, std::vector<node_t *>{&task[1]->event_node});
+
+    librertos_tick_advance(5);
+    test_task_is_ready(task[1]);
+    event_tester(&event, std::vector<node_t *>{});
+}
+
+TEST(EventNewTest, ResumeAll_ResumesEveryTask) {
+    auto task = test_create_tasks({1, 2, 1, 0}, NULL, {NULL});
+
+    for (int i = 0; i < 4; i++) {
+        set_current_task(task[i]);
+        event_delay_task(&event, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    scheduler_lock();
+    event_resume_all(&event);
+    scheduler_unlock();
+
+    for (int i = 0; i < 4; i++)
+        test_task_is_ready(task[i]);
+    event_tester(&event, std::vector<node_t *>{});
+}
+
+TEST(EventNewTest, ResumeAll_NoTask_OK) {
+    event_resume_all(&event);
+    event_tester(&event, std::vector<node_t *>{});
+}
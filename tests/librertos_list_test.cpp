@@ -159,3 +159,72 @@ TEST(List, NodeInList) {
     list_remove(&node1);
     LONGS_EQUAL(0, node_in_list(&node1));
 }
+
+TEST(List, LengthAbove255) {
+    std::vector<node_t> nodes(1000);
+    std::vector<node_t *> pointers;
+
+    for (auto &node : nodes) {
+        node_init(&node, NULL);
+        list_insert_last(&list, &node);
+        pointers.push_back(&node);
+    }
+
+    LONGS_EQUAL(1000, list.length);
+    list_tester(&list, pointers);
+
+    for (auto &node : nodes)
+        list_remove(&node);
+
+    LONGS_EQUAL(1, list_is_empty(&list));
+}
+
+TEST(List, LengthOverflow_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "List size overflow.");
+
+    list.length = (list_len_t)-1;
+
+    CHECK_THROWS(AssertionError, list_insert_last(&list, &node1));
+}
+
+TEST_GROUP (PriorityBitmap) {
+    priority_bitmap_t bitmap;
+
+    void setup() {
+        priority_bitmap_init(&bitmap);
+    }
+    void teardown() {
+    }
+};
+
+TEST(PriorityBitmap, Initialization_Empty) {
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&bitmap));
+}
+
+TEST(PriorityBitmap, SetOne_GetIt) {
+    for (int8_t i = LOW_PRIORITY; i <= HIGH_PRIORITY; i++) {
+        priority_bitmap_init(&bitmap);
+        priority_bitmap_set(&bitmap, i);
+        LONGS_EQUAL(i, priority_bitmap_get_highest(&bitmap));
+    }
+}
+
+TEST(PriorityBitmap, SetAll_GetHighest) {
+    for (int8_t i = LOW_PRIORITY; i <= HIGH_PRIORITY; i++) {
+        priority_bitmap_set(&bitmap, i);
+        LONGS_EQUAL(i, priority_bitmap_get_highest(&bitmap));
+    }
+}
+
+TEST(PriorityBitmap, ClearHighest_GetNextHighest) {
+    priority_bitmap_set(&bitmap, LOW_PRIORITY);
+    priority_bitmap_set(&bitmap, HIGH_PRIORITY);
+
+    priority_bitmap_clear(&bitmap, HIGH_PRIORITY);
+    LONGS_EQUAL(LOW_PRIORITY, priority_bitmap_get_highest(&bitmap));
+
+    priority_bitmap_clear(&bitmap, LOW_PRIORITY);
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&bitmap));
+}
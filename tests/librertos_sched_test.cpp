@@ -579,3 +579,56 @@ TEST(SchedulerStart, Cooperative_IfNotStarted_ScheulerCallsAssertFunction) {
 
     CHECK_THROWS(AssertionError, librertos_sched());
 }
+
+TEST_GROUP (SchedulerReadyBitmap) {
+    void setup() {
+        test_init();
+    }
+    void teardown() {
+    }
+};
+
+TEST(SchedulerReadyBitmap, NoTask_Empty) {
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
+
+TEST(SchedulerReadyBitmap, CreateTasks_HighestReadyPriority) {
+    test_create_tasks({0, 2}, NULL, {NULL});
+
+    LONGS_EQUAL(2, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
+
+TEST(SchedulerReadyBitmap, SuspendAndResume_UpdatesBitmap) {
+    auto task = test_create_tasks({0, 2, 2}, NULL, {NULL});
+
+    task_suspend(task[1]);
+    LONGS_EQUAL(2, priority_bitmap_get_highest(&librertos.priorities_ready));
+
+    task_suspend(task[2]);
+    LONGS_EQUAL(0, priority_bitmap_get_highest(&librertos.priorities_ready));
+
+    task_suspend(task[0]);
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&librertos.priorities_ready));
+
+    task_resume(task[1]);
+    LONGS_EQUAL(2, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
+
+TEST(SchedulerReadyBitmap, ResumeReadyTask_KeepsBitmap) {
+    auto task = test_create_tasks({1}, NULL, {NULL});
+
+    task_resume(task[0]);
+    LONGS_EQUAL(1, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
+
+TEST(SchedulerReadyBitmap, Delay_UpdatesBitmap) {
+    auto task = test_create_tasks({3}, NULL, {NULL});
+
+    set_current_task(task[0]);
+    task_delay(1);
+    set_current_task(NULL);
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&librertos.priorities_ready));
+
+    librertos_tick_interrupt();
+    LONGS_EQUAL(3, priority_bitmap_get_highest(&librertos.priorities_ready));
+}
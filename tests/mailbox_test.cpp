@@ -0,0 +1,201 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (Mailbox) {
+    uint16_t buff;
+    mailbox_t mbx;
+
+    void setup() {
+        mailbox_init(&mbx, &buff, sizeof(buff));
+    }
+    void teardown() {
+    }
+};
+
+TEST(Mailbox, Empty_CannotRead) {
+    uint16_t data = 0xA5;
+    mailbox_version_t version = 0;
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, mailbox_read(&mbx, &data, &version));
+    LONGS_EQUAL(0xA5, data);
+    LONGS_EQUAL(0, version);
+    LONGS_EQUAL(0, mailbox_get_version(&mbx));
+}
+
+TEST(Mailbox, Overwrite_Reads) {
+    uint16_t data = 1234;
+    mailbox_version_t version = 0;
+
+    mailbox_overwrite(&mbx, &data);
+    data = 0;
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mailbox_read(&mbx, &data, &version));
+    LONGS_EQUAL(1234, data);
+    LONGS_EQUAL(1, version);
+}
+
+TEST(Mailbox, ReadTwice_SecondFailsWithoutCopying) {
+    uint16_t data = 1234;
+    mailbox_version_t version = 0;
+
+    mailbox_overwrite(&mbx, &data);
+    mailbox_read(&mbx, &data, &version);
+    data = 0xA5;
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, mailbox_read(&mbx, &data, &version));
+    LONGS_EQUAL(0xA5, data);
+}
+
+TEST(Mailbox, OverwriteTwice_ReadsLatest) {
+    uint16_t data = 1;
+    mailbox_version_t version = 0;
+
+    mailbox_overwrite(&mbx, &data);
+    data = 2;
+    mailbox_overwrite(&mbx, &data);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mailbox_read(&mbx, &data, &version));
+    LONGS_EQUAL(2, data);
+    LONGS_EQUAL(2, version);
+    LONGS_EQUAL(LIBRERTOS_FAIL, mailbox_read(&mbx, &data, &version));
+}
+
+TEST(Mailbox, ManyReaders_EachReadsOnce) {
+    uint16_t data = 7;
+    mailbox_version_t version1 = 0;
+    mailbox_version_t version2 = 0;
+
+    mailbox_overwrite(&mbx, &data);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mailbox_read(&mbx, &data, &version1));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mailbox_read(&mbx, &data, &version2));
+    LONGS_EQUAL(LIBRERTOS_FAIL, mailbox_read(&mbx, &data, &version1));
+    LONGS_EQUAL(LIBRERTOS_FAIL, mailbox_read(&mbx, &data, &version2));
+}
+
+TEST(Mailbox, VersionWraps_SkipsZero) {
+    uint16_t data = 0;
+    mailbox_version_t version = 0;
+
+    for (long i = 0; i <= (mailbox_version_t)-1; i++)
+        mailbox_overwrite(&mbx, &data);
+
+    LONGS_EQUAL(1, mailbox_get_version(&mbx));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mailbox_read(&mbx, &data, &version));
+}
+
+TEST_GROUP (MailboxEvent) {
+    uint16_t buff;
+    mailbox_t mbx;
+
+    void setup() {
+        test_init();
+        mailbox_init(&mbx, &buff, sizeof(buff));
+    }
+    void teardown() {
+    }
+};
+
+TEST(MailboxEvent, TaskSuspends_ResumesWithOverwrite) {
+    uint16_t data = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    mailbox_suspend(&mbx, 0, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    mailbox_overwrite(&mbx, &data);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(MailboxEvent, Overwrite_ResumesAllReaders) {
+    uint16_t data = 0;
+
+    test_create_tasks({0, 1, 2}, NULL, {NULL});
+
+    for (int i = 0; i < 3; i++) {
+        set_current_task(&test.task[i]);
+        mailbox_suspend(&mbx, 0, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    mailbox_overwrite(&mbx, &data);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_ready(&test.task[2]);
+}
+
+TEST(MailboxEvent, NewerVersion_DoesNotSuspend) {
+    uint16_t data = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    mailbox_overwrite(&mbx, &data);
+
+    set_current_task(&test.task[0]);
+    mailbox_suspend(&mbx, 0, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(MailboxEvent, TaskDelays_ResumesWithTickInterrupt) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    mailbox_suspend(&mbx, 0, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(MailboxEvent, ReadSuspend_Success) {
+    uint16_t data = 1234;
+    mailbox_version_t version = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    mailbox_overwrite(&mbx, &data);
+    data = 0;
+
+    set_current_task(&test.task[0]);
+
+    LONGS_EQUAL(1, mailbox_read_suspend(&mbx, &data, &version, MAX_DELAY));
+    LONGS_EQUAL(1234, data);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(MailboxEvent, ReadSuspend_AlreadyRead_Suspends) {
+    uint16_t data = 1234;
+    mailbox_version_t version = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    mailbox_overwrite(&mbx, &data);
+
+    set_current_task(&test.task[0]);
+
+    LONGS_EQUAL(1, mailbox_read_suspend(&mbx, &data, &version, MAX_DELAY));
+    LONGS_EQUAL(0, mailbox_read_suspend(&mbx, &data, &version, MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
@@ -456,6 +456,40 @@ TEST(
         this, {&task[0], &task[1]}, actual_sequence);
 }
 
+TEST(
+    MutexPriorityInversion,
+    HigherPrioritySuspends_OwnerOnFifoEvent_KeepsFifoPosition) {
+    std::vector<task_t *> actual_sequence;
+
+    // Given A low priority task locks the mutex
+    // And A middle and the low priority tasks suspend on a FIFO helper
+    initialize_os(this);
+    initialize_mutex(this);
+    initialize_helper_mutex(this);
+    mutex_set_policy(&helper, EVENT_POLICY_FIFO);
+    create_N_tasks_with_different_priorities(this, 3, &func, &actual_sequence);
+    taskX_is_scheduled_and_locks_mutex(this, 0);
+    interrupt_locks_helper_mutex(this);
+    taskX_is_scheduled_and_suspends_helper_on_mutex(this, 1);
+    taskX_is_scheduled_and_suspends_helper_on_mutex(this, 0);
+
+    // When A high priority task suspends on the mutex
+    taskX_is_scheduled_and_suspends_on_mutex(this, 2);
+
+    // Then The owner inherits the priority and keeps its FIFO position
+    LONGS_EQUAL(2, task[0].priority);
+    list_tester(
+        &helper.event_unlock.suspended_tasks[0],
+        std::vector<node_t *>{&task[1].event_node, &task[0].event_node});
+
+    // When The helper is unlocked
+    helper_mutex_is_unlocked(this);
+    call_the_scheduler(this);
+
+    // Then The first task to wait on the helper is resumed
+    tasks_should_be_scheduled_in_the_order(this, {&task[1]}, actual_sequence);
+}
+
 static void func_lock_mutex_and_resume_2tasks(void *param) {
     void **p = (void **)param;
     std::vector<task_t *> *sequence = (std::vector<task_t *> *)p[0];
@@ -792,7 +826,7 @@ TEST(MutexEventNewTest, TaskDelaysOnEvent_ResumesWithTaskResume) {
     set_current_task(&test.task[0]);
     mutex_suspend(&mtx, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     task_resume(&test.task[0]);
 
@@ -806,7 +840,7 @@ TEST(MutexEventNewTest, TaskDelaysOnEvent_ResumesWithEvent) {
     set_current_task(&test.task[0]);
     mutex_suspend(&mtx, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     mutex_unlock(&mtx);
 
@@ -820,7 +854,7 @@ TEST(MutexEventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt) {
     set_current_task(&test.task[0]);
     mutex_suspend(&mtx, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
@@ -853,5 +887,190 @@ TEST(MutexEventNewTest, TaskLockDelaysOnEvent_Fail) {
     set_current_task(&test.task[0]);
 
     LONGS_EQUAL(0, mutex_lock_suspend(&mtx, 1));
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
+}
+
+TEST(MutexEventNewTest, Handoff_UnlockMakesWaitingTaskOwner) {
+    test_create_tasks({0, 1}, NULL, {NULL});
+    mutex_set_handoff(&mtx, 1);
+
+    set_current_task(&test.task[1]);
+    mutex_lock(&mtx);
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, mutex_lock_suspend(&mtx, MAX_DELAY));
+    set_current_task(&test.task[1]);
+    mutex_unlock(&mtx);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+
+    // Another task cannot steal it.
+    LONGS_EQUAL(0, mutex_lock(&mtx));
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(1, mutex_lock_suspend(&mtx, MAX_DELAY));
+    mutex_unlock(&mtx);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(0, mutex_is_locked(&mtx));
+}
+
+TEST(MutexEventNewTest, Handoff_NewOwnerInheritsPriorityOfWaitingTasks) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+    mutex_set_handoff(&mtx, 1);
+
+    set_current_task(&test.task[1]);
+    mutex_lock(&mtx);
+    set_current_task(&test.task[0]);
+    mutex_suspend(&mtx, MAX_DELAY);
+    set_current_task(&test.task[2]);
+    mutex_suspend(&mtx, MAX_DELAY);
+    set_current_task(&test.task[1]);
+    LONGS_EQUAL(3, test.task[1].priority);
+
+    mutex_unlock(&mtx);
+    set_current_task(NULL);
+
+    // Task 2 (priority 3) gets the mutex first.
+    LONGS_EQUAL(1, test.task[1].priority);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[2]));
+    LONGS_EQUAL(3, test.task[2].priority);
+
+    set_current_task(&test.task[2]);
+    LONGS_EQUAL(1, mutex_lock_suspend(&mtx, MAX_DELAY));
+    mutex_unlock(&mtx);
+    set_current_task(NULL);
+
+    // Task 0 gets it next and has no higher waiting tasks.
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST_GROUP (MutexInheritanceChain) {
+    mutex_t mtx_a;
+    mutex_t mtx_b;
+
+    void setup() {
+        test_init();
+        mutex_init(&mtx_a);
+        mutex_init(&mtx_b);
+    }
+    void teardown() {
+    }
+
+    void lock(task_t *task, mutex_t *mtx) {
+        set_current_task(task);
+        LONGS_EQUAL(1, mutex_lock(mtx));
+        set_current_task(NULL);
+    }
+
+    void suspend(task_t *task, mutex_t *mtx, tick_t ticks) {
+        set_current_task(task);
+        LONGS_EQUAL(0, mutex_lock_suspend(mtx, ticks));
+        set_current_task(NULL);
+    }
+
+    void unlock(task_t *task, mutex_t *mtx) {
+        set_current_task(task);
+        mutex_unlock(mtx);
+        set_current_task(NULL);
+    }
+};
+
+TEST(MutexInheritanceChain, OwnerWaitsForMutex_BoostReachesItsOwner) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+
+    lock(&test.task[0], &mtx_a);
+    lock(&test.task[1], &mtx_b);
+    suspend(&test.task[1], &mtx_a, MAX_DELAY);
+    LONGS_EQUAL(1, test.task[0].priority);
+
+    suspend(&test.task[2], &mtx_b, MAX_DELAY);
+
+    LONGS_EQUAL(3, test.task[1].priority);
+    LONGS_EQUAL(3, test.task[0].priority);
+}
+
+TEST(MutexInheritanceChain, Unlock_FallsBackToWaitersOfMutexesStillHeld) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+
+    lock(&test.task[0], &mtx_a);
+    lock(&test.task[0], &mtx_b);
+    suspend(&test.task[1], &mtx_a, MAX_DELAY);
+    suspend(&test.task[2], &mtx_b, MAX_DELAY);
+    LONGS_EQUAL(3, test.task[0].priority);
+
+    unlock(&test.task[0], &mtx_b);
+    LONGS_EQUAL(1, test.task[0].priority);
+
+    unlock(&test.task[0], &mtx_a);
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST(MutexInheritanceChain, UnlockInAnyOrder_FallsBackToWaitersOfMutexesStillHeld) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+
+    lock(&test.task[0], &mtx_a);
+    lock(&test.task[0], &mtx_b);
+    suspend(&test.task[1], &mtx_b, MAX_DELAY);
+    suspend(&test.task[2], &mtx_a, MAX_DELAY);
+
+    unlock(&test.task[0], &mtx_a);
+    LONGS_EQUAL(1, test.task[0].priority);
+
+    unlock(&test.task[0], &mtx_b);
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST(MutexInheritanceChain, OwnerTimedOut_BoostStopsAtOwner) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+
+    lock(&test.task[0], &mtx_a);
+    lock(&test.task[1], &mtx_b);
+    suspend(&test.task[1], &mtx_a, 1);
+    librertos_tick_interrupt();
+    test_task_is_ready(&test.task[1]);
+
+    suspend(&test.task[2], &mtx_b, MAX_DELAY);
+
+    LONGS_EQUAL(3, test.task[1].priority);
+    LONGS_EQUAL(1, test.task[0].priority);
+}
+
+TEST(MutexInheritanceChain, Deadlock_BoostWalkEnds) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+
+    lock(&test.task[0], &mtx_a);
+    lock(&test.task[1], &mtx_b);
+    suspend(&test.task[0], &mtx_b, MAX_DELAY);
+    suspend(&test.task[1], &mtx_a, MAX_DELAY);
+
+    suspend(&test.task[2], &mtx_a, MAX_DELAY);
+
+    LONGS_EQUAL(3, test.task[0].priority);
+    LONGS_EQUAL(3, test.task[1].priority);
+}
+
+TEST(MutexInheritanceChain, Handoff_NewOwnerKeepsBoostOfOtherMutexes) {
+    test_create_tasks({0, 1, 3}, NULL, {NULL});
+    mutex_set_handoff(&mtx_a, 1);
+
+    lock(&test.task[1], &mtx_a);
+    lock(&test.task[0], &mtx_b);
+    suspend(&test.task[0], &mtx_a, MAX_DELAY);
+    suspend(&test.task[2], &mtx_b, MAX_DELAY);
+    LONGS_EQUAL(3, test.task[1].priority);
+
+    // Task 0 gets mutex A and keeps the boost of the waiter on mutex B.
+    unlock(&test.task[1], &mtx_a);
+    LONGS_EQUAL(1, test.task[1].priority);
+    LONGS_EQUAL(3, test.task[0].priority);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(1, mutex_lock(&mtx_a));
+    mutex_unlock(&mtx_a);
+    LONGS_EQUAL(3, test.task[0].priority);
+    mutex_unlock(&mtx_b);
+    LONGS_EQUAL(0, test.task[0].priority);
+    set_current_task(NULL);
 }
@@ -24,10 +24,26 @@ extern "C" {
 typedef uint16_t tick_t;
 typedef int16_t difftick_t;
 
+#define LIST_LENGTH_TYPE uint16_t
+#define SEMAPHORE_COUNT_TYPE uint16_t
+#define QUEUE_SIZE_TYPE uint16_t
+#define ITEM_SIZE_TYPE uint16_t
+
 #define LIBRERTOS_DISABLE_TIMERS 0
 #define LIBRERTOS_DISABLE_SEMAPHORES 0
 #define LIBRERTOS_DISABLE_MUTEXES 0
+#define LIBRERTOS_DISABLE_CONDVARS 0
+#define LIBRERTOS_DISABLE_RWLOCKS 0
 #define LIBRERTOS_DISABLE_QUEUES 0
+#define LIBRERTOS_DISABLE_SPSC_QUEUES 0
+#define LIBRERTOS_DISABLE_MAILBOXES 0
+#define LIBRERTOS_DISABLE_STREAM_BUFFERS 0
+#define LIBRERTOS_DISABLE_TOPICS 0
+#define LIBRERTOS_DISABLE_CHANNELS 0
+#define LIBRERTOS_DISABLE_BARRIERS 0
+#define LIBRERTOS_DISABLE_TASK_NOTIFICATIONS 0
+#define LIBRERTOS_DISABLE_EVENT_GROUPS 0
+#define LIBRERTOS_DISABLE_QUEUE_SETS 0
 
 extern int8_t kernel_mode;
 
@@ -0,0 +1,226 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (QueueSet) {
+    static const uint8_t que_size = 2;
+    static const uint8_t sem_max = 2;
+    static const uint8_t set_size = 2 * que_size + sem_max;
+
+    void *set_buff[set_size];
+    queue_set_t set;
+
+    uint8_t buff1[que_size];
+    uint8_t buff2[que_size];
+    queue_t que1, que2;
+    semaphore_t sem;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0}, NULL, {NULL});
+
+        queue_set_init(&set, set_buff, set_size);
+        queue_init(&que1, buff1, que_size, 1);
+        queue_init(&que2, buff2, que_size, 1);
+        semaphore_init_locked(&sem, sem_max);
+
+        queue_set_add_queue(&set, &que1);
+        queue_set_add_queue(&set, &que2);
+        queue_set_add_semaphore(&set, &sem);
+    }
+    void teardown() {
+    }
+
+    void *select_suspend(tick_t ticks) {
+        set_current_task(&test.task[0]);
+        void *member = queue_set_select_suspend(&set, ticks);
+        set_current_task(NULL);
+        return member;
+    }
+};
+
+TEST(QueueSet, Empty_SelectsNothing) {
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+}
+
+TEST(QueueSet, QueueWritten_SelectsQueue) {
+    uint8_t data = 5;
+
+    queue_write(&que2, &data);
+
+    POINTERS_EQUAL(&que2, queue_set_select(&set));
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+
+    data = 0;
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_read(&que2, &data));
+    LONGS_EQUAL(5, data);
+}
+
+TEST(QueueSet, SemaphoreUnlocked_SelectsSemaphore) {
+    semaphore_unlock(&sem);
+
+    POINTERS_EQUAL(&sem, queue_set_select(&set));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, semaphore_lock(&sem));
+}
+
+TEST(QueueSet, SelectsInOrderTheyBecameReady) {
+    uint8_t data = 1;
+
+    semaphore_unlock(&sem);
+    queue_write(&que1, &data);
+    queue_write_front(&que2, &data);
+    queue_write(&que1, &data);
+
+    POINTERS_EQUAL(&sem, queue_set_select(&set));
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+    POINTERS_EQUAL(&que2, queue_set_select(&set));
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+}
+
+TEST(QueueSet, WriteN_SelectsQueueForEachItem) {
+    uint8_t data[2] = {1, 2};
+
+    LONGS_EQUAL(2, queue_write_n(&que1, data, 2));
+
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+}
+
+TEST(QueueSet, WriteCommit_SelectsQueue) {
+    *(uint8_t *)queue_write_reserve(&que1) = 3;
+    queue_write_commit(&que1);
+
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+}
+
+TEST(QueueSet, PeekRelease_ConsumesSelectedItem) {
+    uint8_t data = 3;
+
+    queue_write(&que1, &data);
+
+    POINTERS_EQUAL(&que1, queue_set_select(&set));
+    LONGS_EQUAL(3, *(uint8_t *)queue_read_peek(&que1));
+    queue_read_release(&que1);
+
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+    LONGS_EQUAL(0, queue_get_num_used(&que1));
+}
+
+TEST(QueueSet, ReadNMoreThanOneItem_CallsAssertFunction) {
+    uint8_t data[2] = {1, 2};
+
+    LONGS_EQUAL(2, queue_write_n(&que1, data, 2));
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Queue set members are read one item at a time.");
+
+    CHECK_THROWS(AssertionError, queue_read_n(&que1, data, 2));
+}
+
+TEST(QueueSet, LockNMoreThanOneUnit_CallsAssertFunction) {
+    semaphore_unlock_n(&sem, 2);
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Queue set members are locked one unit at a time.");
+
+    CHECK_THROWS(AssertionError, semaphore_lock_n(&sem, 2));
+}
+
+TEST(QueueSet, NothingReady_Suspends) {
+    POINTERS_EQUAL(NULL, select_suspend(MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(QueueSet, AnyMemberReady_ResumesTask) {
+    uint8_t data = 7;
+
+    select_suspend(MAX_DELAY);
+    queue_write(&que2, &data);
+    test_task_is_ready(&test.task[0]);
+    POINTERS_EQUAL(&que2, select_suspend(MAX_DELAY));
+
+    select_suspend(MAX_DELAY);
+    semaphore_unlock(&sem);
+    test_task_is_ready(&test.task[0]);
+    POINTERS_EQUAL(&sem, select_suspend(MAX_DELAY));
+}
+
+TEST(QueueSet, MemberReadyFromInterrupt_ResumesTask) {
+    select_suspend(MAX_DELAY);
+
+    task_t *interrupted_task = interrupt_lock();
+    semaphore_unlock(&sem);
+    interrupt_unlock(interrupted_task);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueSet, Delayed_ResumesWithTickInterrupt) {
+    select_suspend(1);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    POINTERS_EQUAL(NULL, select_suspend(MAX_DELAY));
+}
+
+TEST(QueueSet, RemovedMember_NotSelected) {
+    uint8_t data = 1;
+
+    queue_set_remove_queue(&set, &que1);
+    queue_set_remove_semaphore(&set, &sem);
+
+    queue_write(&que1, &data);
+    semaphore_unlock(&sem);
+
+    POINTERS_EQUAL(NULL, queue_set_select(&set));
+}
+
+TEST(QueueSet, AddTwice_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Already in a queue set.");
+
+    CHECK_THROWS(AssertionError, queue_set_add_queue(&set, &que1));
+}
+
+TEST(QueueSet, AddNotEmpty_CallsAssertFunction) {
+    semaphore_t sem2;
+    semaphore_init_unlocked(&sem2, 1);
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Queue set member must be empty.");
+
+    CHECK_THROWS(AssertionError, queue_set_add_semaphore(&set, &sem2));
+}
+
+TEST(QueueSet, RemoveFromOtherSet_CallsAssertFunction) {
+    queue_set_t set2;
+    void *set2_buff[1];
+    queue_set_init(&set2, set2_buff, 1);
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Not in this queue set.");
+
+    CHECK_THROWS(AssertionError, queue_set_remove_queue(&set2, &que1));
+}
@@ -28,12 +28,12 @@ static const que_struct que_struct_val_A = {0x5B5B5B5B};
 static const que_struct que_struct_val_B = {0x5C5C5C5C};
 static const que_struct que_struct_val_C = {0x5D5D5D5D};
 
-static void initialize_buff(que_struct *buff, uint8_t size) {
+static void initialize_buff(que_struct *buff, unsigned size) {
     // First and last elements of buff are guards
     memset(buff, 0x5A, size * sizeof(que_struct));
 }
 
-static void finalize_buff(que_struct *buff, uint8_t size) {
+static void finalize_buff(que_struct *buff, unsigned size) {
     que_struct expected;
 
     // Initialize expected and validate both guards
@@ -258,6 +258,368 @@ TEST(Queue_Size0, NumFree_NumUsed_Empty_Full_NumItems_ItemSize) {
     LONGS_EQUAL(sizeof(que_struct), queue_get_item_size(&que));
 }
 
+TEST_GROUP (Queue_Burst) {
+    static const uint8_t que_size = 4;
+    static const uint8_t buff_size = que_size + que_guards;
+
+    que_struct buff[buff_size];
+    queue_t que;
+
+    void setup() {
+        initialize_buff(&buff[0], buff_size);
+        queue_init(&que, &buff[1], que_size, sizeof(que_struct));
+    }
+
+    void teardown() {
+        finalize_buff(&buff[0], buff_size);
+    }
+};
+
+TEST(Queue_Burst, Empty_ReadN_ReadsNothing) {
+    que_struct data[2];
+    LONGS_EQUAL(0, queue_read_n(&que, &data[0], 2));
+}
+
+TEST(Queue_Burst, WriteN_ReadN_FirstInFirstOut) {
+    que_struct in[3] = {que_struct_val_A, que_struct_val_B, que_struct_val_C};
+    que_struct out[3] = {que_struct_zero, que_struct_zero, que_struct_zero};
+
+    LONGS_EQUAL(3, queue_write_n(&que, &in[0], 3));
+    LONGS_EQUAL(1, queue_get_num_free(&que));
+    LONGS_EQUAL(3, queue_get_num_used(&que));
+
+    LONGS_EQUAL(3, queue_read_n(&que, &out[0], 3));
+    MEMCMP_EQUAL(&in[0], &out[0], sizeof(in));
+    LONGS_EQUAL(1, queue_is_empty(&que));
+}
+
+TEST(Queue_Burst, WriteN_MoreThanFree_WritesOnlyFree) {
+    que_struct in[6] = {};
+    que_struct out[6];
+
+    for (uint32_t i = 0; i < 6; i++)
+        in[i].x = i;
+
+    LONGS_EQUAL(4, queue_write_n(&que, &in[0], 6));
+    LONGS_EQUAL(0, queue_write_n(&que, &in[4], 2));
+    LONGS_EQUAL(1, queue_is_full(&que));
+
+    LONGS_EQUAL(4, queue_read_n(&que, &out[0], 6));
+    MEMCMP_EQUAL(&in[0], &out[0], 4 * sizeof(que_struct));
+}
+
+TEST(Queue_Burst, WriteN_ReadN_WrapsHead_WrapsTail) {
+    que_struct in[4] = {};
+    que_struct out[4];
+    que_struct data;
+
+    for (uint32_t i = 0; i < 4; i++)
+        in[i].x = i + 10;
+
+    // Move head and tail to the middle of the buffer
+    queue_write(&que, &que_struct_val_A);
+    queue_write(&que, &que_struct_val_B);
+    queue_write(&que, &que_struct_val_C);
+    queue_read(&que, &data);
+    queue_read(&que, &data);
+
+    // Write wraps around the end of the buffer
+    LONGS_EQUAL(3, queue_write_n(&que, &in[0], 3));
+
+    // Read wraps around the end of the buffer
+    LONGS_EQUAL(4, queue_read_n(&que, &out[0], 4));
+    MEMCMP_EQUAL(&que_struct_val_C, &out[0], sizeof(que_struct));
+    MEMCMP_EQUAL(&in[0], &out[1], 3 * sizeof(que_struct));
+
+    // Mix with single item operations
+    LONGS_EQUAL(4, queue_write_n(&que, &in[0], 4));
+    for (uint32_t i = 0; i < 4; i++) {
+        queue_read(&que, &data);
+        LONGS_EQUAL(i + 10, data.x);
+    }
+}
+
+TEST(Queue_Burst, Empty_PeekReturnsNull) {
+    POINTERS_EQUAL(NULL, queue_read_peek(&que));
+}
+
+TEST(Queue_Burst, Full_ReserveReturnsNull) {
+    que_struct in[4] = {};
+
+    queue_write_n(&que, &in[0], 4);
+
+    POINTERS_EQUAL(NULL, queue_write_reserve(&que));
+}
+
+TEST(Queue_Burst, ReserveCommit_PeekRelease_InPlace) {
+    que_struct *item = (que_struct *)queue_write_reserve(&que);
+
+    POINTERS_EQUAL(&buff[1], item);
+    LONGS_EQUAL(1, queue_is_empty(&que));
+
+    *item = que_struct_val_A;
+    queue_write_commit(&que);
+    LONGS_EQUAL(1, queue_get_num_used(&que));
+
+    item = (que_struct *)queue_read_peek(&que);
+    POINTERS_EQUAL(&buff[1], item);
+    MEMCMP_EQUAL(&que_struct_val_A, item, sizeof(que_struct));
+    LONGS_EQUAL(1, queue_get_num_used(&que));
+
+    queue_read_release(&que);
+    LONGS_EQUAL(1, queue_is_empty(&que));
+}
+
+TEST(Queue_Burst, ReserveCommit_PeekRelease_WrapsHead_WrapsTail) {
+    que_struct data;
+
+    for (uint32_t i = 0; i < 10; i++) {
+        que_struct *item = (que_struct *)queue_write_reserve(&que);
+        item->x = i;
+        queue_write_commit(&que);
+
+        if (i % 2 == 0) {
+            item = (que_struct *)queue_read_peek(&que);
+            LONGS_EQUAL(i, item->x);
+            queue_read_release(&que);
+        } else {
+            queue_read(&que, &data);
+            LONGS_EQUAL(i, data.x);
+        }
+    }
+}
+
+TEST(Queue_Burst, CommitFull_CallsAssertFunction) {
+    que_struct in[4] = {};
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "No item to commit.");
+
+    queue_write_n(&que, &in[0], 4);
+
+    CHECK_THROWS(AssertionError, queue_write_commit(&que));
+}
+
+TEST(Queue_Burst, ReleaseEmpty_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "No item to release.");
+
+    CHECK_THROWS(AssertionError, queue_read_release(&que));
+}
+
+TEST_GROUP (Queue_Size1024) {
+    static const uint16_t que_size = 1024;
+    static const uint16_t buff_size = que_size + que_guards;
+
+    que_struct buff[buff_size];
+    queue_t que;
+
+    void setup() {
+        initialize_buff(&buff[0], buff_size);
+        queue_init(&que, &buff[1], que_size, sizeof(que_struct));
+    }
+
+    void teardown() {
+        finalize_buff(&buff[0], buff_size);
+    }
+};
+
+TEST(Queue_Size1024, Fill_FirstInFirstOut_WrapsHead_WrapsTail) {
+    for (int round = 0; round < 2; round++) {
+        for (uint32_t i = 0; i < que_size; i++) {
+            que_struct data = {i + round};
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_write(&que, &data));
+        }
+        LONGS_EQUAL(LIBRERTOS_FAIL, queue_write(&que, &que_struct_val_A));
+        LONGS_EQUAL(que_size, queue_get_num_used(&que));
+
+        for (uint32_t i = 0; i < que_size; i++) {
+            que_struct data;
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_read(&que, &data));
+            LONGS_EQUAL(i + round, data.x);
+        }
+        LONGS_EQUAL(que_size, queue_get_num_free(&que));
+    }
+}
+
+TEST(Queue_Size1024, NumFree_NumUsed_Empty_Full_NumItems_ItemSize) {
+    LONGS_EQUAL(1024, queue_get_num_free(&que));
+    LONGS_EQUAL(0, queue_get_num_used(&que));
+    LONGS_EQUAL(1, queue_is_empty(&que));
+    LONGS_EQUAL(0, queue_is_full(&que));
+    LONGS_EQUAL(1024, queue_get_num_items(&que));
+    LONGS_EQUAL(sizeof(que_struct), queue_get_item_size(&que));
+}
+
+TEST_GROUP (Queue_LargeItems) {
+    static const uint16_t item_size = 300;
+    static const uint8_t que_size = 3;
+
+    uint8_t buff[que_size * item_size];
+    queue_t que;
+
+    void setup() {
+        queue_init(&que, &buff[0], que_size, item_size);
+    }
+    void teardown() {
+    }
+};
+
+TEST(Queue_LargeItems, FirstInFirstOut_WrapsHead_WrapsTail) {
+    uint8_t data[item_size];
+
+    LONGS_EQUAL(item_size, queue_get_item_size(&que));
+
+    for (uint8_t i = 0; i < 5; i++) {
+        memset(&data[0], i, item_size);
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_write(&que, &data[0]));
+
+        memset(&data[0], 0, item_size);
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_read(&que, &data[0]));
+        LONGS_EQUAL(i, data[0]);
+        LONGS_EQUAL(i, data[item_size - 1]);
+    }
+}
+
+TEST(Queue_Size2, WriteFront_ReadsFirst) {
+    que_struct data = que_struct_zero;
+    queue_write(&que, &que_struct_val_A);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, queue_write_front(&que, &que_struct_val_B));
+
+    queue_read(&que, &data);
+    MEMCMP_EQUAL(&que_struct_val_B, &data, sizeof(data));
+    queue_read(&que, &data);
+    MEMCMP_EQUAL(&que_struct_val_A, &data, sizeof(data));
+}
+
+TEST(Queue_Size2, WriteFront_WrapsTail) {
+    que_struct data = que_struct_zero;
+    queue_write(&que, &que_struct_val_A);
+    queue_read(&que, &data);
+
+    queue_write_front(&que, &que_struct_val_B);
+    queue_write_front(&que, &que_struct_val_C);
+
+    queue_read(&que, &data);
+    MEMCMP_EQUAL(&que_struct_val_C, &data, sizeof(data));
+    queue_read(&que, &data);
+    MEMCMP_EQUAL(&que_struct_val_B, &data, sizeof(data));
+    LONGS_EQUAL(1, queue_is_empty(&que));
+}
+
+TEST(Queue_Size2, WriteFront_Full_Fails) {
+    queue_write(&que, &que_struct_val_A);
+    queue_write(&que, &que_struct_val_B);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, queue_write_front(&que, &que_struct_val_C));
+}
+
+TEST_GROUP (PrioQueue) {
+    static const uint8_t que_size = 4;
+
+    uint16_t buff[que_size];
+    queue_size_t links[que_size];
+    prio_queue_t que;
+
+    void setup() {
+        test_init();
+        prio_queue_init(&que, &buff[0], &links[0], que_size, sizeof(buff[0]));
+    }
+    void teardown() {
+    }
+};
+
+TEST(PrioQueue, Empty_CannotRead) {
+    uint16_t data;
+    LONGS_EQUAL(LIBRERTOS_FAIL, prio_queue_read(&que, &data, NULL));
+    LONGS_EQUAL(0, prio_queue_get_num_used(&que));
+    LONGS_EQUAL(que_size, prio_queue_get_num_free(&que));
+}
+
+TEST(PrioQueue, ReadsHighestPriorityFirst_FifoWithinPriority) {
+    uint16_t data;
+    uint8_t priority;
+
+    data = 1;
+    prio_queue_write(&que, &data, 0);
+    data = 2;
+    prio_queue_write(&que, &data, 2);
+    data = 3;
+    prio_queue_write(&que, &data, 0);
+    data = 4;
+    prio_queue_write(&que, &data, 2);
+
+    const uint16_t expected_data[] = {2, 4, 1, 3};
+    const uint8_t expected_priority[] = {2, 2, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, prio_queue_read(&que, &data, &priority));
+        LONGS_EQUAL(expected_data[i], data);
+        LONGS_EQUAL(expected_priority[i], priority);
+    }
+    LONGS_EQUAL(LIBRERTOS_FAIL, prio_queue_read(&que, &data, NULL));
+}
+
+TEST(PrioQueue, Full_CannotWrite_ReusesSlots) {
+    uint16_t data = 0;
+
+    for (int round = 0; round < 3; round++) {
+        for (uint16_t i = 0; i < que_size; i++) {
+            data = i;
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, prio_queue_write(&que, &data, (uint8_t)(i % PRIO_QUEUE_LEVELS)));
+        }
+        LONGS_EQUAL(LIBRERTOS_FAIL, prio_queue_write(&que, &data, 0));
+        LONGS_EQUAL(0, prio_queue_get_num_free(&que));
+
+        for (uint16_t i = 0; i < que_size; i++) {
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, prio_queue_read(&que, &data, NULL));
+            LONGS_EQUAL(que_size - 1 - i, data);
+        }
+    }
+}
+
+TEST(PrioQueue, InvalidPriority_CallsAssertFunction) {
+    uint16_t data = 0;
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Invalid item priority.");
+
+    CHECK_THROWS(
+        AssertionError, prio_queue_write(&que, &data, PRIO_QUEUE_LEVELS));
+}
+
+TEST(PrioQueue, TaskSuspends_ResumesWithWrite) {
+    uint16_t data = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, prio_queue_read_suspend(&que, &data, NULL, MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    prio_queue_write(&que, &data, 1);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(PrioQueue, NotEmpty_DoesNotSuspend) {
+    uint16_t data = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    prio_queue_write(&que, &data, 1);
+
+    set_current_task(&test.task[0]);
+    prio_queue_suspend(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_ready(&test.task[0]);
+}
+
 TEST_GROUP (QueueEvent) {
     char buff[BUFF_SIZE];
 
@@ -448,7 +810,7 @@ TEST(QueueEventNewTest, TaskDelaysOnEvent_ResumesWithTaskResume) {
     set_current_task(&test.task[0]);
     queue_suspend(&que, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     task_resume(&test.task[0]);
 
@@ -463,7 +825,7 @@ TEST(QueueEventNewTest, TaskDelaysOnEvent_ResumesWithEvent) {
     set_current_task(&test.task[0]);
     queue_suspend(&que, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     queue_write(&que, &data);
 
@@ -476,7 +838,7 @@ TEST(QueueEventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt) {
     set_current_task(&test.task[0]);
     queue_suspend(&que, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
@@ -518,5 +880,265 @@ TEST(QueueEventNewTest, TaskReadDelaysOnEvent_Fail) {
 
     LONGS_EQUAL(0, queue_read_suspend(&que, &data_r, 1));
     LONGS_EQUAL(0xA5, data_r);
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, WriteN_ResumesOneTaskPerItem) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0, 1, 2}, NULL, {NULL});
+
+    for (int i = 0; i < 3; i++) {
+        set_current_task(&test.task[i]);
+        queue_suspend(&que, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, WriteN_FewerWaitingTasks_ResumesAll) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    queue_suspend(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, WriteCommit_ResumesTask) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    queue_suspend(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    *(uint8_t *)queue_write_reserve(&que) = 5;
+    test_task_is_suspended(&test.task[0]);
+
+    queue_write_commit(&que);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, TaskWriteWaitsOnEvent_ResumesWithRead) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0}, NULL, {NULL});
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    set_current_task(&test.task[0]);
+    queue_write_wait(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    queue_read(&que, &data[0]);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, TaskWriteWaitsOnEvent_NotFull_DoesNotSuspend) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    queue_write_wait(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, TaskWriteWaitsOnEvent_ResumesWithTickInterrupt) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0}, NULL, {NULL});
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    set_current_task(&test.task[0]);
+    queue_write_wait(&que, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, TaskWriteSuspendOnEvent_Success) {
+    uint8_t data_w = 0x5A;
+    uint8_t data_r = 0xA5;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+
+    LONGS_EQUAL(1, queue_write_suspend(&que, &data_w, MAX_DELAY));
+    test_task_is_ready(&test.task[0]);
+
+    LONGS_EQUAL(1, queue_read(&que, &data_r));
+    LONGS_EQUAL(0x5A, data_r);
+}
+
+TEST(QueueEventNewTest, TaskWriteSuspendOnEvent_Fail) {
+    uint8_t data[2] = {1, 2};
+    uint8_t data_w = 0x5A;
+
+    test_create_tasks({0}, NULL, {NULL});
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    set_current_task(&test.task[0]);
+
+    LONGS_EQUAL(0, queue_write_suspend(&que, &data_w, MAX_DELAY));
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, ReadN_ResumesOneWriterPerItem) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0, 1, 2}, NULL, {NULL});
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    for (int i = 0; i < 3; i++) {
+        set_current_task(&test.task[i]);
+        queue_write_wait(&que, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    LONGS_EQUAL(2, queue_read_n(&que, &data[0], 2));
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, ReadRelease_ResumesWriter) {
+    uint8_t data[2] = {1, 2};
+
+    test_create_tasks({0}, NULL, {NULL});
+    LONGS_EQUAL(2, queue_write_n(&que, &data[0], 2));
+
+    set_current_task(&test.task[0]);
+    queue_write_wait(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, *(uint8_t *)queue_read_peek(&que));
+    test_task_is_suspended(&test.task[0]);
+
+    queue_read_release(&que);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(QueueEventNewTest, Handoff_WriteCopiesToWaitingReader) {
+    uint8_t data_w = 0x5A;
+    static uint8_t data_r = 0;
+
+    test_create_tasks({0, 1}, NULL, {NULL});
+    queue_set_handoff(&que, 1);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, queue_read_suspend(&que, &data_r, MAX_DELAY));
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, queue_write(&que, &data_w));
+
+    LONGS_EQUAL(0x5A, data_r);
+    LONGS_EQUAL(0, queue_get_num_used(&que));
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+
+    // The resumed task completes the read without copying again.
+    data_r = 0;
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(1, queue_read_suspend(&que, &data_r, MAX_DELAY));
+    LONGS_EQUAL(0, data_r);
+    LONGS_EQUAL(0, queue_read_suspend(&que, &data_r, MAX_DELAY));
+    set_current_task(NULL);
+}
+
+TEST(QueueEventNewTest, Handoff_ReaderWithoutBuffer_WritesToQueue) {
+    uint8_t data_w = 0x5A;
+
+    test_create_tasks({0}, NULL, {NULL});
+    queue_set_handoff(&que, 1);
+
+    set_current_task(&test.task[0]);
+    queue_suspend(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, queue_write(&que, &data_w));
+
+    LONGS_EQUAL(1, queue_get_num_used(&que));
+    LONGS_EQUAL(TASK_WAKE_RESUMED, task_get_wake_result(&test.task[0]));
+}
+
+TEST(QueueEventNewTest, Handoff_WriteFrontCopiesToWaitingReader) {
+    uint8_t data_w = 0x5A;
+    static uint8_t data_r = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    queue_set_handoff(&que, 1);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, queue_read_suspend(&que, &data_r, MAX_DELAY));
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, queue_write_front(&que, &data_w));
+
+    LONGS_EQUAL(0x5A, data_r);
+    LONGS_EQUAL(0, queue_get_num_used(&que));
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+}
+
+TEST(QueueEventNewTest, Handoff_WriteCommitCopiesToWaitingReader) {
+    static uint8_t data_r = 0;
+
+    test_create_tasks({0}, NULL, {NULL});
+    queue_set_handoff(&que, 1);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, queue_read_suspend(&que, &data_r, MAX_DELAY));
+    set_current_task(NULL);
+
+    *(uint8_t *)queue_write_reserve(&que) = 0x5A;
+    queue_write_commit(&que);
+
+    LONGS_EQUAL(0x5A, data_r);
+    LONGS_EQUAL(0, queue_get_num_used(&que));
+    LONGS_EQUAL(2, queue_get_num_free(&que));
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+}
+
+TEST(QueueEventNewTest, Handoff_WriteNCopiesOneItemToEachWaitingReader) {
+    uint8_t data_w[4] = {1, 2, 3, 4};
+    static uint8_t data_r[2] = {0, 0};
+    uint8_t data[2];
+
+    test_create_tasks({0, 1}, NULL, {NULL});
+    queue_set_handoff(&que, 1);
+
+    for (int i = 0; i < 2; i++) {
+        set_current_task(&test.task[i]);
+        LONGS_EQUAL(0, queue_read_suspend(&que, &data_r[i], MAX_DELAY));
+    }
+    set_current_task(NULL);
+
+    LONGS_EQUAL(4, queue_write_n(&que, &data_w[0], 4));
+
+    // Higher priority first.
+    LONGS_EQUAL(1, data_r[1]);
+    LONGS_EQUAL(2, data_r[0]);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[1]));
+
+    LONGS_EQUAL(2, queue_read_n(&que, &data[0], 2));
+    LONGS_EQUAL(3, data[0]);
+    LONGS_EQUAL(4, data[1]);
 }
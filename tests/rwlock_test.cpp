@@ -0,0 +1,264 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (RwLock) {
+    rwlock_t rw;
+
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1, 2, 3}, NULL, {NULL});
+        rwlock_init(&rw);
+    }
+    void teardown() {
+    }
+
+    result_t read_lock(task_t *task) {
+        set_current_task(task);
+        result_t result = rwlock_read_lock_suspend(&rw, MAX_DELAY);
+        set_current_task(NULL);
+        return result;
+    }
+
+    result_t write_lock(task_t *task) {
+        set_current_task(task);
+        result_t result = rwlock_write_lock_suspend(&rw, MAX_DELAY);
+        set_current_task(NULL);
+        return result;
+    }
+
+    void read_unlock(task_t *task) {
+        set_current_task(task);
+        rwlock_read_unlock(&rw);
+        set_current_task(NULL);
+    }
+
+    void write_unlock(task_t *task) {
+        set_current_task(task);
+        rwlock_write_unlock(&rw);
+        set_current_task(NULL);
+    }
+};
+
+TEST(RwLock, ManyReaders) {
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, rwlock_read_lock(&rw));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, rwlock_read_lock(&rw));
+    LONGS_EQUAL(LIBRERTOS_FAIL, rwlock_write_lock(&rw));
+
+    rwlock_read_unlock(&rw);
+    LONGS_EQUAL(LIBRERTOS_FAIL, rwlock_write_lock(&rw));
+
+    rwlock_read_unlock(&rw);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, rwlock_write_lock(&rw));
+}
+
+TEST(RwLock, OneWriter) {
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, rwlock_write_lock(&rw));
+    LONGS_EQUAL(LIBRERTOS_FAIL, rwlock_write_lock(&rw));
+    LONGS_EQUAL(LIBRERTOS_FAIL, rwlock_read_lock(&rw));
+
+    rwlock_write_unlock(&rw);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, rwlock_read_lock(&rw));
+}
+
+TEST(RwLock, LastReaderUnlock_ResumesWriter) {
+    read_lock(&test.task[0]);
+    read_lock(&test.task[1]);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, write_lock(&test.task[2]));
+    test_task_is_suspended(&test.task[2]);
+
+    read_unlock(&test.task[0]);
+    test_task_is_suspended(&test.task[2]);
+
+    read_unlock(&test.task[1]);
+    test_task_is_ready(&test.task[2]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, write_lock(&test.task[2]));
+}
+
+TEST(RwLock, WriteUnlock_ResumesAllReaders) {
+    write_lock(&test.task[3]);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, read_lock(&test.task[0]));
+    LONGS_EQUAL(LIBRERTOS_FAIL, read_lock(&test.task[1]));
+    LONGS_EQUAL(LIBRERTOS_FAIL, write_lock(&test.task[2]));
+
+    write_unlock(&test.task[3]);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_suspended(&test.task[2]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, read_lock(&test.task[0]));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, read_lock(&test.task[1]));
+}
+
+TEST(RwLock, WriteUnlock_NoReaders_ResumesWriter) {
+    write_lock(&test.task[3]);
+    write_lock(&test.task[2]);
+
+    write_unlock(&test.task[3]);
+
+    test_task_is_ready(&test.task[2]);
+}
+
+TEST(RwLock, ReaderPreference_ReadersLockWhileWriterWaits) {
+    read_lock(&test.task[0]);
+    write_lock(&test.task[2]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, read_lock(&test.task[1]));
+}
+
+TEST(RwLock, WriterPreference_ReadersWaitWhileWriterWaits) {
+    rwlock_set_writer_preference(&rw, 1);
+
+    read_lock(&test.task[0]);
+    write_lock(&test.task[2]);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, read_lock(&test.task[1]));
+    test_task_is_suspended(&test.task[1]);
+
+    read_unlock(&test.task[0]);
+    test_task_is_ready(&test.task[2]);
+    test_task_is_suspended(&test.task[1]);
+}
+
+TEST(RwLock, WriterPreference_WriteUnlockResumesWriterFirst) {
+    rwlock_set_writer_preference(&rw, 1);
+
+    write_lock(&test.task[3]);
+    read_lock(&test.task[0]);
+    write_lock(&test.task[2]);
+
+    write_unlock(&test.task[3]);
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_suspended(&test.task[0]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, write_lock(&test.task[2]));
+    write_unlock(&test.task[2]);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(RwLock, Writer_InheritsPriorityOfWaitingTasks) {
+    write_lock(&test.task[0]);
+
+    read_lock(&test.task[2]);
+    LONGS_EQUAL(2, test.task[0].priority);
+
+    write_lock(&test.task[3]);
+    LONGS_EQUAL(3, test.task[0].priority);
+
+    write_unlock(&test.task[0]);
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST(RwLock, Writer_LowerPriorityWaiting_KeepsPriority) {
+    write_lock(&test.task[2]);
+
+    read_lock(&test.task[0]);
+
+    LONGS_EQUAL(2, test.task[2].priority);
+}
+
+TEST(RwLock, WriterUnlocksMutex_KeepsPriorityOfLockWaiters) {
+    mutex_t mtx;
+    mutex_init(&mtx);
+
+    write_lock(&test.task[0]);
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mutex_lock(&mtx));
+    set_current_task(NULL);
+
+    set_current_task(&test.task[1]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, mutex_lock_suspend(&mtx, MAX_DELAY));
+    set_current_task(NULL);
+    write_lock(&test.task[3]);
+    LONGS_EQUAL(3, test.task[0].priority);
+
+    set_current_task(&test.task[0]);
+    mutex_unlock(&mtx);
+    set_current_task(NULL);
+    LONGS_EQUAL(3, test.task[0].priority);
+
+    write_unlock(&test.task[0]);
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST(RwLock, WriterUnlocksLock_KeepsPriorityOfMutexWaiters) {
+    mutex_t mtx;
+    mutex_init(&mtx);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, mutex_lock(&mtx));
+    set_current_task(NULL);
+    write_lock(&test.task[0]);
+
+    read_lock(&test.task[1]);
+    set_current_task(&test.task[2]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, mutex_lock_suspend(&mtx, MAX_DELAY));
+    set_current_task(NULL);
+    LONGS_EQUAL(2, test.task[0].priority);
+
+    write_unlock(&test.task[0]);
+    LONGS_EQUAL(2, test.task[0].priority);
+
+    set_current_task(&test.task[0]);
+    mutex_unlock(&mtx);
+    set_current_task(NULL);
+    LONGS_EQUAL(0, test.task[0].priority);
+}
+
+TEST(RwLock, Delayed_ResumesWithTickInterrupt) {
+    write_lock(&test.task[3]);
+
+    set_current_task(&test.task[0]);
+    rwlock_read_lock_suspend(&rw, 1);
+    set_current_task(NULL);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, read_lock(&test.task[0]));
+}
+
+TEST(RwLock, ReadUnlockUnlocked_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Read lock already unlocked.");
+
+    CHECK_THROWS(AssertionError, rwlock_read_unlock(&rw));
+}
+
+TEST(RwLock, WriteUnlockUnlocked_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Write lock already unlocked.");
+
+    CHECK_THROWS(AssertionError, rwlock_write_unlock(&rw));
+}
+
+TEST(RwLock, SuspendWithoutTask_CallsAssertFunction) {
+    rwlock_write_lock(&rw);
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(AssertionError, rwlock_read_suspend(&rw, MAX_DELAY));
+}
@@ -132,6 +132,20 @@ TEST(Sempahore, Counting_GetCount_GetMax) {
     LONGS_EQUAL(2, semaphore_get_max(&sem));
 }
 
+TEST(Sempahore, CountingAbove255_GetCount_GetMax) {
+    semaphore_init_locked(&sem, 1000);
+    LONGS_EQUAL(1000, semaphore_get_max(&sem));
+
+    for (int i = 0; i < 1000; i++)
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, semaphore_unlock(&sem));
+    LONGS_EQUAL(LIBRERTOS_FAIL, semaphore_unlock(&sem));
+    LONGS_EQUAL(1000, semaphore_get_count(&sem));
+
+    for (int i = 0; i < 1000; i++)
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, semaphore_lock(&sem));
+    LONGS_EQUAL(LIBRERTOS_FAIL, semaphore_lock(&sem));
+}
+
 TEST(Sempahore, InvalidInitCount_CallsAssertFunction) {
     mock()
         .expectOneCall("librertos_assert")
@@ -316,7 +330,7 @@ TEST(SemaphoreEventNewTest, TaskDelaysOnEvent_ResumesWithTaskResume) {
     set_current_task(&test.task[0]);
     semaphore_suspend(&sem, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     task_resume(&test.task[0]);
 
@@ -329,7 +343,7 @@ TEST(SemaphoreEventNewTest, TaskDelaysOnEvent_ResumesWithEvent) {
     set_current_task(&test.task[0]);
     semaphore_suspend(&sem, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     semaphore_unlock(&sem);
 
@@ -342,7 +356,7 @@ TEST(SemaphoreEventNewTest, TaskDelaysOnEvent_ResumesWithTickInterrupt) {
     set_current_task(&test.task[0]);
     semaphore_suspend(&sem, 1);
 
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
 
     librertos_tick_interrupt();
 
@@ -374,5 +388,323 @@ TEST(SemaphoreEventNewTest, TaskLockDelaysOnEvent_Fail) {
     set_current_task(&test.task[0]);
 
     LONGS_EQUAL(0, semaphore_lock_suspend(&sem, 1));
-    test_task_is_delayed_current(&test.task[0]);
+    test_task_is_delayed(&test.task[0]);
+}
+
+TEST(SemaphoreEventNewTest, PolicyPriority_ResumesHigherPriorityFirst) {
+    auto task = test_create_tasks({0, 2, 1}, NULL, {NULL});
+
+    for (int i = 0; i < 3; i++) {
+        set_current_task(task[i]);
+        semaphore_suspend(&sem, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[1]);
+    test_task_is_suspended(task[2]);
+
+    task_resume(task[1]);
+    semaphore_lock(&sem);
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[2]);
+    test_task_is_suspended(task[0]);
+}
+
+TEST(SemaphoreEventNewTest, PolicyFifo_ResumesInArrivalOrder) {
+    auto task = test_create_tasks({0, 2, 1}, NULL, {NULL});
+
+    semaphore_set_policy(&sem, EVENT_POLICY_FIFO);
+
+    for (int i = 0; i < 3; i++) {
+        set_current_task(task[i]);
+        semaphore_suspend(&sem, MAX_DELAY);
+    }
+    set_current_task(NULL);
+
+    list_tester(
+        &sem.event_unlock.suspended_tasks[0],
+        std::vector<node_t *>{
+            &task[0]->event_node, &task[1]->event_node, &task[2]->event_node});
+
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[0]);
+    test_task_is_suspended(task[1]);
+
+    semaphore_lock(&sem);
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[1]);
+    test_task_is_suspended(task[2]);
+
+    semaphore_lock(&sem);
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[2]);
+    LONGS_EQUAL(-1, priority_bitmap_get_highest(&sem.event_unlock.priorities));
+}
+
+TEST(SemaphoreEventNewTest, PolicyFifo_DelayedTaskTimesOut_RemovedFromEvent) {
+    auto task = test_create_tasks({0, 1}, NULL, {NULL});
+
+    semaphore_set_policy(&sem, EVENT_POLICY_FIFO);
+
+    set_current_task(task[0]);
+    semaphore_suspend(&sem, 1);
+    set_current_task(task[1]);
+    semaphore_suspend(&sem, MAX_DELAY);
+    set_current_task(NULL);
+
+    librertos_tick_interrupt();
+    test_task_is_ready(task[0]);
+    list_tester(
+        &sem.event_unlock.suspended_tasks[0],
+        std::vector<node_t *>{&task[1]->event_node});
+
+    semaphore_unlock(&sem);
+    test_task_is_ready(task[1]);
+}
+
+TEST(SemaphoreEventNewTest, SetPolicyWithTasksWaiting_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot change the policy with tasks waiting.");
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    semaphore_suspend(&sem, MAX_DELAY);
+    set_current_task(NULL);
+
+    CHECK_THROWS(
+        AssertionError, semaphore_set_policy(&sem, EVENT_POLICY_FIFO));
+}
+
+TEST(SemaphoreEventNewTest, WakeResult_ResumedByUnlock) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    LONGS_EQUAL(TASK_WAKE_NONE, task_get_wake_result(&test.task[0]));
+
+    set_current_task(&test.task[0]);
+    semaphore_suspend(&sem, MAX_DELAY);
+    set_current_task(NULL);
+
+    semaphore_unlock(&sem);
+
+    LONGS_EQUAL(TASK_WAKE_RESUMED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreEventNewTest, WakeResult_ResumedByTaskResume) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    semaphore_suspend(&sem, MAX_DELAY);
+    set_current_task(NULL);
+
+    task_resume(&test.task[0]);
+
+    LONGS_EQUAL(TASK_WAKE_RESUMED, task_get_wake_result(&test.task[0]));
+}
+
+TEST(SemaphoreEventNewTest, WakeResult_TimedOut) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    semaphore_suspend(&sem, 1);
+    LONGS_EQUAL(TASK_WAKE_NONE, task_get_wake_result(NULL));
+    set_current_task(NULL);
+
+    librertos_tick_interrupt();
+
+    LONGS_EQUAL(TASK_WAKE_TIMED_OUT, task_get_wake_result(&test.task[0]));
+}
+
+TEST(SemaphoreEventNewTest, Handoff_UnlockGrantsToWaitingTask) {
+    test_create_tasks({0, 1}, NULL, {NULL});
+    semaphore_set_handoff(&sem, 1);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, semaphore_lock_suspend(&sem, MAX_DELAY));
+    set_current_task(NULL);
+
+    semaphore_unlock(&sem);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(TASK_WAKE_ACQUIRED, task_get_wake_result(&test.task[0]));
+    LONGS_EQUAL(0, semaphore_get_count(&sem));
+
+    // Another task cannot steal it.
+    set_current_task(&test.task[1]);
+    LONGS_EQUAL(0, semaphore_lock(&sem));
+
+    // The resumed task gets it once.
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(1, semaphore_lock_suspend(&sem, MAX_DELAY));
+    LONGS_EQUAL(0, semaphore_lock(&sem));
+    set_current_task(NULL);
+
+    LONGS_EQUAL(1, semaphore_unlock(&sem));
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreEventNewTest, Handoff_NoTaskWaiting_IncrementsCount) {
+    semaphore_set_handoff(&sem, 1);
+
+    semaphore_unlock(&sem);
+
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreEventNewTest, Handoff_TimedOutTask_DoesNotGetGrant) {
+    test_create_tasks({0}, NULL, {NULL});
+    semaphore_set_handoff(&sem, 1);
+
+    set_current_task(&test.task[0]);
+    semaphore_lock_suspend(&sem, 1);
+    set_current_task(NULL);
+
+    librertos_tick_interrupt();
+    semaphore_unlock(&sem);
+
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+    LONGS_EQUAL(TASK_WAKE_TIMED_OUT, task_get_wake_result(&test.task[0]));
+}
+
+TEST_GROUP (SemaphoreCountN) {
+    semaphore_t sem;
+
+    void setup() {
+        test_init();
+        semaphore_init_locked(&sem, 16);
+    }
+    void teardown() {
+    }
+
+    result_t lock_n_suspend(task_t *task, sem_count_t num) {
+        set_current_task(task);
+        result_t result = semaphore_lock_n_suspend(&sem, num, MAX_DELAY);
+        set_current_task(NULL);
+        return result;
+    }
+};
+
+TEST(SemaphoreCountN, UnlockN_AddsUnits) {
+    LONGS_EQUAL(10, semaphore_unlock_n(&sem, 10));
+    LONGS_EQUAL(10, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, UnlockN_LimitedByMaximum) {
+    semaphore_unlock_n(&sem, 10);
+
+    LONGS_EQUAL(6, semaphore_unlock_n(&sem, 10));
+    LONGS_EQUAL(16, semaphore_get_count(&sem));
+    LONGS_EQUAL(0, semaphore_unlock_n(&sem, 1));
+}
+
+TEST(SemaphoreCountN, LockN_AllOrNone) {
+    semaphore_unlock_n(&sem, 5);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, semaphore_lock_n(&sem, 6));
+    LONGS_EQUAL(5, semaphore_get_count(&sem));
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, semaphore_lock_n(&sem, 4));
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, UnlockN_ResumesAllTasksThatFit) {
+    test_create_tasks({0, 1, 2}, NULL, {NULL});
+
+    lock_n_suspend(&test.task[0], 1);
+    lock_n_suspend(&test.task[1], 1);
+    lock_n_suspend(&test.task[2], 1);
+
+    semaphore_unlock_n(&sem, 2);
+
+    // Higher priority first.
+    test_task_is_suspended(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    test_task_is_ready(&test.task[2]);
+    LONGS_EQUAL(2, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, UnlockN_SkipsTasksWaitingForMore) {
+    test_create_tasks({0, 1}, NULL, {NULL});
+
+    lock_n_suspend(&test.task[1], 4);
+    lock_n_suspend(&test.task[0], 1);
+
+    semaphore_unlock_n(&sem, 3);
+
+    test_task_is_suspended(&test.task[1]);
+    test_task_is_ready(&test.task[0]);
+
+    semaphore_unlock(&sem);
+    test_task_is_ready(&test.task[1]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock_n_suspend(&test.task[1], 4));
+    LONGS_EQUAL(0, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, Unlock_DoesNotResumeTaskWaitingForMore) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, lock_n_suspend(&test.task[0], 2));
+
+    semaphore_unlock(&sem);
+    test_task_is_suspended(&test.task[0]);
+
+    semaphore_unlock(&sem);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(SemaphoreCountN, LockNSuspend_Available_DoesNotSuspend) {
+    test_create_tasks({0}, NULL, {NULL});
+    semaphore_unlock_n(&sem, 3);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock_n_suspend(&test.task[0], 3));
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(SemaphoreCountN, Handoff_UnlockNGrantsUnitsToEachTask) {
+    test_create_tasks({0, 1, 2}, NULL, {NULL});
+    semaphore_set_handoff(&sem, 1);
+
+    lock_n_suspend(&test.task[2], 2);
+    lock_n_suspend(&test.task[1], 3);
+    lock_n_suspend(&test.task[0], 1);
+
+    LONGS_EQUAL(4, semaphore_unlock_n(&sem, 4));
+
+    test_task_is_ready(&test.task[2]);
+    test_task_is_suspended(&test.task[1]);
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock_n_suspend(&test.task[2], 2));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, lock_n_suspend(&test.task[0], 1));
+    LONGS_EQUAL(1, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, UnlockNFromInterrupt_ResumesTasks) {
+    test_create_tasks({0, 1}, NULL, {NULL});
+
+    lock_n_suspend(&test.task[0], 1);
+    lock_n_suspend(&test.task[1], 1);
+
+    task_t *interrupted_task = interrupt_lock();
+    semaphore_unlock_n(&sem, 16);
+    interrupt_unlock(interrupted_task);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+    LONGS_EQUAL(16, semaphore_get_count(&sem));
+}
+
+TEST(SemaphoreCountN, LockNSuspendAboveMaximum_CallsAssertFunction) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot wait for more than the maximum value.");
+
+    CHECK_THROWS(AssertionError, lock_n_suspend(&test.task[0], 17));
 }
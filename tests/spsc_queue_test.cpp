@@ -0,0 +1,158 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (SpscQueue) {
+    static const uint8_t que_size = 4;
+
+    uint16_t buff[que_size];
+    spsc_queue_t que;
+
+    void setup() {
+        spsc_queue_init(&que, &buff[0], que_size, sizeof(buff[0]));
+    }
+    void teardown() {
+    }
+};
+
+TEST(SpscQueue, Empty_CannotRead) {
+    uint16_t data;
+    LONGS_EQUAL(LIBRERTOS_FAIL, spsc_queue_read(&que, &data));
+    LONGS_EQUAL(0, spsc_queue_get_num_used(&que));
+}
+
+TEST(SpscQueue, Empty_Writes) {
+    uint16_t data = 5;
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_write(&que, &data));
+    LONGS_EQUAL(1, spsc_queue_get_num_used(&que));
+}
+
+TEST(SpscQueue, Full_CannotWrite) {
+    uint16_t data = 5;
+
+    for (int i = 0; i < que_size; i++)
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_write(&que, &data));
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, spsc_queue_write(&que, &data));
+    LONGS_EQUAL(que_size, spsc_queue_get_num_used(&que));
+}
+
+TEST(SpscQueue, FirstInFirstOut_IndexesWrapAround) {
+    uint16_t data;
+
+    // The indexes (uint16_t in the tests) overflow after 65536 items.
+    for (uint32_t i = 0; i < 70000; i++) {
+        data = (uint16_t)i;
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_write(&que, &data));
+        if (i % 3 == 0) {
+            data = (uint16_t)(i + 1);
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_write(&que, &data));
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_read(&que, &data));
+            LONGS_EQUAL((uint16_t)i, data);
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_read(&que, &data));
+            LONGS_EQUAL((uint16_t)(i + 1), data);
+        } else {
+            LONGS_EQUAL(LIBRERTOS_SUCCESS, spsc_queue_read(&que, &data));
+            LONGS_EQUAL((uint16_t)i, data);
+        }
+    }
+
+    LONGS_EQUAL(0, spsc_queue_get_num_used(&que));
+}
+
+TEST(SpscQueue, SizeNotPowerOfTwo_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Queue size must be a power of two.");
+
+    CHECK_THROWS(
+        AssertionError, spsc_queue_init(&que, &buff[0], 3, sizeof(buff[0])));
+}
+
+TEST_GROUP (SpscQueueEvent) {
+    uint8_t buff[2];
+    spsc_queue_t que;
+
+    void setup() {
+        test_init();
+        spsc_queue_init(&que, &buff[0], sizeof(buff), sizeof(buff[0]));
+    }
+    void teardown() {
+    }
+};
+
+TEST(SpscQueueEvent, Write_NoConsumerSuspended_DoesNotResume) {
+    uint8_t data = 1;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    spsc_queue_write(&que, &data);
+
+    LONGS_EQUAL(0, que.consumer_suspended);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(SpscQueueEvent, TaskSuspendsOnEvent_ResumesWithWrite) {
+    uint8_t data = 1;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, spsc_queue_read_suspend(&que, &data, MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+    LONGS_EQUAL(1, que.consumer_suspended);
+
+    spsc_queue_write(&que, &data);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(0, que.consumer_suspended);
+}
+
+TEST(SpscQueueEvent, NotEmpty_DoesNotSuspend) {
+    uint8_t data = 1;
+
+    test_create_tasks({0}, NULL, {NULL});
+    spsc_queue_write(&que, &data);
+
+    set_current_task(&test.task[0]);
+    spsc_queue_suspend(&que, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(0, que.consumer_suspended);
+}
+
+TEST(SpscQueueEvent, TaskDelaysOnEvent_ResumesWithTickInterrupt) {
+    uint8_t data = 1;
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    spsc_queue_suspend(&que, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+
+    // Stale flag: the next write only checks that nobody waits.
+    spsc_queue_write(&que, &data);
+    LONGS_EQUAL(0, que.consumer_suspended);
+}
@@ -0,0 +1,218 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+#include <string.h>
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (StreamBuffer) {
+    static const uint8_t buff_size = 8;
+
+    uint8_t buff[buff_size];
+    stream_buffer_t stm;
+
+    void setup() {
+        test_init();
+        stream_buffer_init(&stm, &buff[0], buff_size, 3);
+    }
+    void teardown() {
+    }
+};
+
+TEST(StreamBuffer, Empty_CannotRead) {
+    uint8_t data[4];
+    LONGS_EQUAL(0, stream_buffer_read(&stm, &data[0], sizeof(data)));
+    LONGS_EQUAL(0, stream_buffer_get_num_used(&stm));
+    LONGS_EQUAL(buff_size, stream_buffer_get_num_free(&stm));
+}
+
+TEST(StreamBuffer, WritesAndReadsBytes) {
+    uint8_t data[4] = {0};
+
+    LONGS_EQUAL(5, stream_buffer_write(&stm, "hello", 5));
+    LONGS_EQUAL(5, stream_buffer_get_num_used(&stm));
+
+    LONGS_EQUAL(4, stream_buffer_read(&stm, &data[0], 4));
+    MEMCMP_EQUAL("hell", &data[0], 4);
+    LONGS_EQUAL(1, stream_buffer_read(&stm, &data[0], 4));
+    LONGS_EQUAL('o', data[0]);
+}
+
+TEST(StreamBuffer, Full_WritesOnlyWhatFits) {
+    LONGS_EQUAL(5, stream_buffer_write(&stm, "hello", 5));
+    LONGS_EQUAL(3, stream_buffer_write(&stm, "world", 5));
+    LONGS_EQUAL(0, stream_buffer_write(&stm, "!", 1));
+    LONGS_EQUAL(0, stream_buffer_get_num_free(&stm));
+}
+
+TEST(StreamBuffer, WrapsHeadAndTail) {
+    char data[8] = {0};
+
+    for (int round = 0; round < 5; round++) {
+        LONGS_EQUAL(5, stream_buffer_write(&stm, "abcde", 5));
+        LONGS_EQUAL(5, stream_buffer_read(&stm, &data[0], sizeof(data)));
+        MEMCMP_EQUAL("abcde", &data[0], 5);
+    }
+    LONGS_EQUAL(0, stream_buffer_get_num_used(&stm));
+}
+
+TEST(StreamBuffer, InvalidTrigger_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Invalid trigger level.");
+
+    CHECK_THROWS(
+        AssertionError, stream_buffer_init(&stm, &buff[0], buff_size, 0));
+}
+
+TEST(StreamBuffer, BelowTrigger_TaskSuspends_ResumesAtTrigger) {
+    uint8_t data[4];
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, stream_buffer_read_suspend(&stm, &data[0], sizeof(data), MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    stream_buffer_write(&stm, "ab", 2);
+    test_task_is_suspended(&test.task[0]);
+
+    stream_buffer_write(&stm, "c", 1);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(StreamBuffer, AtTrigger_ReadSuspendReads) {
+    uint8_t data[4] = {0};
+
+    test_create_tasks({0}, NULL, {NULL});
+    stream_buffer_write(&stm, "abc", 3);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(3, stream_buffer_read_suspend(&stm, &data[0], sizeof(data), MAX_DELAY));
+    set_current_task(NULL);
+
+    MEMCMP_EQUAL("abc", &data[0], 3);
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(StreamBuffer, BelowTrigger_ResumesWithTickInterrupt) {
+    uint8_t data[4] = {0};
+
+    test_create_tasks({0}, NULL, {NULL});
+    stream_buffer_write(&stm, "a", 1);
+
+    set_current_task(&test.task[0]);
+    stream_buffer_suspend(&stm, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+    LONGS_EQUAL(1, stream_buffer_read(&stm, &data[0], sizeof(data)));
+}
+
+TEST_GROUP (MessageBuffer) {
+    static const uint8_t buff_size = 16;
+
+    uint8_t buff[buff_size];
+    message_buffer_t msg;
+
+    void setup() {
+        test_init();
+        message_buffer_init(&msg, &buff[0], buff_size);
+    }
+    void teardown() {
+    }
+};
+
+TEST(MessageBuffer, Empty_CannotRead) {
+    char data[8];
+    LONGS_EQUAL(1, message_buffer_is_empty(&msg));
+    LONGS_EQUAL(0, message_buffer_read(&msg, &data[0], sizeof(data)));
+    LONGS_EQUAL(0, message_buffer_get_next_length(&msg));
+}
+
+TEST(MessageBuffer, ReadsWholeMessagesInOrder) {
+    char data[8] = {0};
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, message_buffer_write(&msg, "abc", 3));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, message_buffer_write(&msg, "de", 2));
+
+    LONGS_EQUAL(3, message_buffer_read(&msg, &data[0], sizeof(data)));
+    MEMCMP_EQUAL("abc", &data[0], 3);
+    LONGS_EQUAL(2, message_buffer_read(&msg, &data[0], sizeof(data)));
+    MEMCMP_EQUAL("de", &data[0], 2);
+    LONGS_EQUAL(1, message_buffer_is_empty(&msg));
+}
+
+TEST(MessageBuffer, NoSpaceForWholeMessage_Fails) {
+    const size_t header = sizeof(item_size_t);
+    const item_size_t size = (item_size_t)(buff_size - header);
+    uint8_t data[buff_size] = {0};
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, message_buffer_write(&msg, &data[0], (item_size_t)(size + 1)));
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, message_buffer_write(&msg, &data[0], size));
+    LONGS_EQUAL(LIBRERTOS_FAIL, message_buffer_write(&msg, &data[0], 1));
+}
+
+TEST(MessageBuffer, MessageLargerThanBuffer_IsKept) {
+    char data[8] = {0};
+
+    message_buffer_write(&msg, "abcdef", 6);
+
+    LONGS_EQUAL(0, message_buffer_read(&msg, &data[0], 5));
+    LONGS_EQUAL(0, message_buffer_is_empty(&msg));
+    LONGS_EQUAL(6, message_buffer_get_next_length(&msg));
+    LONGS_EQUAL(6, message_buffer_read(&msg, &data[0], 6));
+    MEMCMP_EQUAL("abcdef", &data[0], 6);
+}
+
+TEST(MessageBuffer, WrapsLengthAndData) {
+    char data[8] = {0};
+
+    for (int round = 0; round < 7; round++) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, message_buffer_write(&msg, "abcde", 5));
+        LONGS_EQUAL(5, message_buffer_read(&msg, &data[0], sizeof(data)));
+        MEMCMP_EQUAL("abcde", &data[0], 5);
+    }
+}
+
+TEST(MessageBuffer, EmptyMessage_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Message cannot be empty.");
+
+    CHECK_THROWS(AssertionError, message_buffer_write(&msg, "", 0));
+}
+
+TEST(MessageBuffer, TaskSuspends_ResumesWithWrite) {
+    char data[8];
+
+    test_create_tasks({0}, NULL, {NULL});
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(0, message_buffer_read_suspend(&msg, &data[0], sizeof(data), MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+
+    message_buffer_write(&msg, "a", 1);
+
+    test_task_is_ready(&test.task[0]);
+}
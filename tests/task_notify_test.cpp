@@ -0,0 +1,185 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (TaskNotify) {
+    void setup() {
+        test_init();
+        test_create_tasks({0, 1}, NULL, {NULL});
+    }
+    void teardown() {
+    }
+
+    result_t wait(task_t *task, notify_value_t clear_bits, notify_value_t *value, tick_t ticks) {
+        set_current_task(task);
+        result_t result = task_notify_wait(clear_bits, value, ticks);
+        set_current_task(NULL);
+        return result;
+    }
+};
+
+TEST(TaskNotify, NotNotified_Suspends) {
+    notify_value_t value = 0xA5;
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], 0, &value, MAX_DELAY));
+    LONGS_EQUAL(0xA5, value);
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(TaskNotify, NotifiedBefore_DoesNotSuspend) {
+    notify_value_t value = 0;
+
+    task_notify(&test.task[0], NOTIFY_OVERWRITE, 7);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, &value, MAX_DELAY));
+    LONGS_EQUAL(7, value);
+    test_task_is_ready(&test.task[0]);
+
+    // Consumed.
+    LONGS_EQUAL(LIBRERTOS_FAIL, wait(&test.task[0], 0, &value, MAX_DELAY));
+}
+
+TEST(TaskNotify, Waiting_NotifyResumes) {
+    notify_value_t value = 0;
+
+    wait(&test.task[0], 0, &value, MAX_DELAY);
+    test_task_is_suspended(&test.task[0]);
+
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x01);
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, &value, MAX_DELAY));
+    LONGS_EQUAL(0x01, value);
+}
+
+TEST(TaskNotify, SetBits_AccumulatesAndClearsOnExit) {
+    notify_value_t value = 0;
+
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x01);
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x04);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0x01, &value, MAX_DELAY));
+    LONGS_EQUAL(0x05, value);
+
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x02);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], (notify_value_t)-1, &value, MAX_DELAY));
+    LONGS_EQUAL(0x06, value);
+
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x00);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, &value, MAX_DELAY));
+    LONGS_EQUAL(0x00, value);
+}
+
+TEST(TaskNotify, Increment_CountsNotifications) {
+    notify_value_t value = 0;
+
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], (notify_value_t)-1, &value, MAX_DELAY));
+    LONGS_EQUAL(3, value);
+}
+
+TEST(TaskNotify, Overwrite_ReplacesValue) {
+    notify_value_t value = 0;
+
+    task_notify(&test.task[0], NOTIFY_SET_BITS, 0x0F);
+    task_notify(&test.task[0], NOTIFY_OVERWRITE, 0x30);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, &value, MAX_DELAY));
+    LONGS_EQUAL(0x30, value);
+}
+
+TEST(TaskNotify, NullValue_IsAllowed) {
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, NULL, MAX_DELAY));
+}
+
+TEST(TaskNotify, Delayed_ResumesWithTickInterrupt) {
+    wait(&test.task[0], 0, NULL, 1);
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(TaskNotify, Delayed_NotifyResumes) {
+    wait(&test.task[0], 0, NULL, 10);
+    test_task_is_delayed(&test.task[0]);
+
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(TaskNotify, TimedOutThenWaitingForEvent_NotifyDoesNotResume) {
+    semaphore_t sem;
+    semaphore_init_locked(&sem, 1);
+
+    wait(&test.task[0], 0, NULL, 1);
+    librertos_tick_interrupt();
+
+    set_current_task(&test.task[0]);
+    semaphore_suspend(&sem, MAX_DELAY);
+    set_current_task(NULL);
+
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(TaskNotify, TimedOutThenDelayed_NotifyDoesNotResume) {
+    wait(&test.task[0], 0, NULL, 2);
+    librertos_tick_interrupt();
+    librertos_tick_interrupt();
+    test_task_is_ready(&test.task[0]);
+
+    set_current_task(&test.task[0]);
+    task_delay(100);
+    set_current_task(NULL);
+
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    test_task_is_delayed(&test.task[0]);
+
+    // The notification is kept for the next wait.
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, wait(&test.task[0], 0, NULL, MAX_DELAY));
+}
+
+TEST(TaskNotify, ResumedThenSuspended_NotifyDoesNotResume) {
+    wait(&test.task[0], 0, NULL, MAX_DELAY);
+    task_resume(&test.task[0]);
+
+    set_current_task(&test.task[0]);
+    task_suspend(NULL);
+    set_current_task(NULL);
+
+    task_notify(&test.task[0], NOTIFY_INCREMENT, 0);
+
+    test_task_is_suspended(&test.task[0]);
+}
+
+TEST(TaskNotify, WaitWithoutTask_CallsAssertFunction) {
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot delay without a task.");
+
+    CHECK_THROWS(AssertionError, task_notify_wait(0, NULL, MAX_DELAY));
+}
@@ -0,0 +1,225 @@
+/* Copyright (c) 2016-2023 Djones A. Boni - MIT License */
+
+#define LIBRERTOS_DEBUG_DECLARATIONS
+#include "librertos.h"
+#include "tests/utils/librertos_custom_tests.h"
+#include "tests/utils/librertos_test_utils.h"
+
+/*
+ * Main file: src/librertos.c
+ * Also compile: tests/mocks/librertos_assert.cpp
+ * Also compile: tests/utils/librertos_custom_tests.cpp
+ * Also compile: tests/utils/librertos_test_utils.cpp
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+TEST_GROUP (Topic) {
+    static const uint8_t que_size = 3;
+
+    uint16_t buff[que_size];
+    topic_t top;
+    subscriber_t sub1;
+    subscriber_t sub2;
+
+    void setup() {
+        test_init();
+        topic_init(&top, &buff[0], que_size, sizeof(buff[0]));
+    }
+    void teardown() {
+    }
+
+    void publish(uint16_t value) {
+        topic_publish(&top, &value);
+    }
+};
+
+TEST(Topic, NothingPublished_CannotRead) {
+    uint16_t data;
+
+    topic_subscribe(&top, &sub1);
+
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read(&sub1, &data));
+}
+
+TEST(Topic, AllSubscribersReadEachItem) {
+    uint16_t data;
+
+    topic_subscribe(&top, &sub1);
+    topic_subscribe(&top, &sub2);
+
+    publish(10);
+    publish(20);
+
+    for (uint16_t value = 10; value <= 20; value += 10) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+        LONGS_EQUAL(value, data);
+    }
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read(&sub1, &data));
+
+    for (uint16_t value = 10; value <= 20; value += 10) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub2, &data));
+        LONGS_EQUAL(value, data);
+    }
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read(&sub2, &data));
+}
+
+TEST(Topic, SubscribeLater_ReadsOnlyNewItems) {
+    uint16_t data;
+
+    publish(10);
+    topic_subscribe(&top, &sub1);
+    publish(20);
+
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+    LONGS_EQUAL(20, data);
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read(&sub1, &data));
+}
+
+TEST(Topic, SlowSubscriber_SkipsAhead) {
+    uint16_t data;
+
+    topic_subscribe(&top, &sub1);
+    topic_subscribe(&top, &sub2);
+
+    for (uint16_t value = 1; value <= 5; value++)
+        publish(value);
+
+    // Keeps the last three items.
+    for (uint16_t value = 3; value <= 5; value++) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+        LONGS_EQUAL(value, data);
+    }
+    LONGS_EQUAL(2, topic_get_num_skipped(&sub1));
+
+    publish(6);
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+    LONGS_EQUAL(6, data);
+    LONGS_EQUAL(2, topic_get_num_skipped(&sub1));
+
+    // Other subscriber is independent.
+    LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub2, &data));
+    LONGS_EQUAL(4, data);
+    LONGS_EQUAL(3, topic_get_num_skipped(&sub2));
+}
+
+TEST(Topic, SequenceWraps) {
+    uint16_t data;
+
+    topic_subscribe(&top, &sub1);
+
+    for (long i = 0; i < 70000; i++) {
+        publish((uint16_t)i);
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+        LONGS_EQUAL((uint16_t)i, data);
+    }
+    LONGS_EQUAL(0, topic_get_num_skipped(&sub1));
+}
+
+TEST(Topic, SlowSubscriber_SequenceWraps_ReadsOldestItems) {
+    uint16_t data;
+
+    // Size 3 does not divide the range of the sequence.
+    topic_subscribe(&top, &sub1);
+    for (long i = 0; i < 65534; i++) {
+        publish(0);
+        topic_read(&sub1, &data);
+    }
+
+    // The sequence wraps while the subscriber falls behind.
+    for (uint16_t value = 1; value <= 3; value++)
+        publish(value);
+
+    for (uint16_t value = 1; value <= 3; value++) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+        LONGS_EQUAL(value, data);
+    }
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read(&sub1, &data));
+
+    // And skips ahead to the oldest item.
+    for (uint16_t value = 4; value <= 8; value++)
+        publish(value);
+
+    for (uint16_t value = 6; value <= 8; value++) {
+        LONGS_EQUAL(LIBRERTOS_SUCCESS, topic_read(&sub1, &data));
+        LONGS_EQUAL(value, data);
+    }
+    LONGS_EQUAL(2, topic_get_num_skipped(&sub1));
+}
+
+TEST(Topic, Unsubscribe_RemovesSubscriber) {
+    topic_subscribe(&top, &sub1);
+    topic_unsubscribe(&sub1);
+
+    LONGS_EQUAL(1, list_is_empty(&top.subscribers));
+    publish(10);
+}
+
+TEST(Topic, TaskSuspends_ResumesWithPublish) {
+    uint16_t data;
+
+    test_create_tasks({0, 1}, NULL, {NULL});
+
+    topic_subscribe(&top, &sub1);
+    topic_subscribe(&top, &sub2);
+
+    set_current_task(&test.task[0]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read_suspend(&sub1, &data, MAX_DELAY));
+    set_current_task(&test.task[1]);
+    LONGS_EQUAL(LIBRERTOS_FAIL, topic_read_suspend(&sub2, &data, MAX_DELAY));
+    set_current_task(NULL);
+
+    test_task_is_suspended(&test.task[0]);
+    test_task_is_suspended(&test.task[1]);
+
+    publish(10);
+
+    test_task_is_ready(&test.task[0]);
+    test_task_is_ready(&test.task[1]);
+}
+
+TEST(Topic, ItemAvailable_DoesNotSuspend) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    topic_subscribe(&top, &sub1);
+    publish(10);
+
+    set_current_task(&test.task[0]);
+    topic_suspend(&sub1, MAX_DELAY);
+    set_current_task(NULL);
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(Topic, TaskDelays_ResumesWithTickInterrupt) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    topic_subscribe(&top, &sub1);
+
+    set_current_task(&test.task[0]);
+    topic_suspend(&sub1, 1);
+    set_current_task(NULL);
+
+    test_task_is_delayed(&test.task[0]);
+
+    librertos_tick_interrupt();
+
+    test_task_is_ready(&test.task[0]);
+}
+
+TEST(Topic, UnsubscribeWithTaskWaiting_CallsAssertFunction) {
+    test_create_tasks({0}, NULL, {NULL});
+
+    topic_subscribe(&top, &sub1);
+
+    set_current_task(&test.task[0]);
+    topic_suspend(&sub1, MAX_DELAY);
+    set_current_task(NULL);
+
+    mock()
+        .expectOneCall("librertos_assert")
+        .withParameter("msg", "Cannot unsubscribe with tasks waiting.");
+
+    CHECK_THROWS(AssertionError, topic_unsubscribe(&sub1));
+}
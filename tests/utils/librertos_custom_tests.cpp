@@ -58,6 +58,31 @@ void list_tester(list_t *list, std::vector<node_t *> nodes) {
     POINTERS_EQUAL(list, nodes[nodes.size() - 1]->list);
 }
 
+/* Check the tasks waiting for the event, in the order they are resumed. */
+void event_tester(event_t *event, std::vector<node_t *> nodes) {
+    auto node = nodes.begin();
+
+    for (int8_t i = EVENT_PRIORITY_LISTS - 1; i >= 0; i--) {
+        std::vector<node_t *> bucket;
+
+        while (node != nodes.end() &&
+               ((task_t *)(*node)->owner)->priority * EVENT_PRIORITY_LISTS / NUM_PRIORITIES == i)
+            bucket.push_back(*node++);
+
+        list_tester(&event->suspended_tasks[i], bucket);
+    }
+
+    // Nodes are in priority order
+    CHECK_TRUE(node == nodes.end());
+
+    // Bitmap is OK
+    int8_t highest = -1;
+    for (int8_t i = EVENT_PRIORITY_LISTS - 1; i >= 0 && highest < 0; i--)
+        if (event->suspended_tasks[i].length != 0)
+            highest = i;
+    CHECK_TRUE(priority_bitmap_get_highest(&event->priorities) == highest);
+}
+
 test_t test;
 
 void test_init() {
@@ -97,6 +122,15 @@ std::vector<task_t *> test_create_tasks(
     return task_vec;
 }
 
+/* Check if the list is one of the timing wheel buckets. */
+bool test_list_is_delayed(list_t *list) {
+    for (uint8_t i = 0; i < TIMING_WHEEL_LEVELS; i++)
+        for (uint8_t j = 0; j < TIMING_WHEEL_SIZE; j++)
+            if (list == &librertos.tasks_delayed[i][j])
+                return true;
+    return false;
+}
+
 /* Convert a std::vector<int> to a string. */
 SimpleString StringFrom(std::vector<int> &vec) {
     std::stringstream s;
@@ -22,6 +22,7 @@ extern "C" {
     #include "CppUTestExt/MockSupport.h"
 
 void list_tester(list_t *list, std::vector<node_t *> nodes);
+void event_tester(event_t *event, std::vector<node_t *> nodes);
 
 /*******************************************************************************
  * LibreRTOS
@@ -152,16 +153,15 @@ void test_init();
 std::vector<task_t *> test_create_tasks(
     std::vector<uint8_t> prio, task_function_t func, std::vector<void *> param);
 
+bool test_list_is_delayed(list_t *list);
+
     #define test_task_is_ready(task) \
         POINTERS_EQUAL( \
             &librertos.tasks_ready[(task)->priority], (task)->sched_node.list)
     #define test_task_is_suspended(task) \
         POINTERS_EQUAL(&librertos.tasks_suspended, (task)->sched_node.list)
-    #define test_task_is_delayed_current(task) \
-        POINTERS_EQUAL(librertos.tasks_delayed_current, (task)->sched_node.list)
-    #define test_task_is_delayed_overflow(task) \
-        POINTERS_EQUAL( \
-            librertos.tasks_delayed_overflow, (task)->sched_node.list)
+    #define test_task_is_delayed(task) \
+        CHECK_TRUE(test_list_is_delayed((task)->sched_node.list))
 
 SimpleString StringFrom(std::vector<int> &vec);
 